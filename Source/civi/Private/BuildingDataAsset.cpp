@@ -12,4 +12,9 @@ FBuildingDisplayData UBuildingDataAsset::GetBuildingDisplayData(EBuildingType Ty
         }
     }
     return FBuildingDisplayData();
+}
+
+const FBuildingDisplayData* UBuildingDataAsset::FindBuildingDisplayData(EBuildingType Type) const
+{
+    return BuildingData.FindByPredicate([Type](const FBuildingDisplayData& Data) { return Data.BuildingType == Type; });
 }
\ No newline at end of file
@@ -146,6 +146,17 @@ void ACity::OnCityCaptured(int32 NewOwnerIndex)
 {
     UE_LOG(LogTemp, Error, TEXT("CITY CAPTURED! %s is now owned by Player %d"), *CityName.ToString(), NewOwnerIndex);
 
+    ACivi_GameModeBase* GM = Cast<ACivi_GameModeBase>(UGameplayStatics::GetGameMode(GetWorld()));
+
+    // ǰ֪ͨϷģʽеҼסɵ
+    if (GM)
+    {
+        for (ULandblock* Tile : OwnedTiles)
+        {
+            GM->NotifyTileStateChanging(Tile);
+        }
+    }
+
     PlayerOwnerIndex = NewOwnerIndex;
     CurrentHP = 50; // ռָѪ
     Population = FMath::Max(1, Population / 2); // ˿ڼ
@@ -155,8 +166,11 @@ void ACity::OnCityCaptured(int32 NewOwnerIndex)
     bHasActiveProduction = false;
 
     // ֪ͨ GameMode ʤ
-    if (ACivi_GameModeBase* GM = Cast<ACivi_GameModeBase>(UGameplayStatics::GetGameMode(GetWorld())))
+    if (GM)
     {
+        // Ұתµ
+        GM->UpdateSightObserver(this, NewOwnerIndex, GridX, GridY, FHexVisibility::CitySightRadius);
+
         GM->CheckVictoryConditions();
     }
 }
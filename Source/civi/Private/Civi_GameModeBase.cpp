@@ -3,11 +3,18 @@
 
 #include "Civi_GameModeBase.h"
 #include "Landblock.h"
+#include "Building.h"
 #include "EngineUtils.h"
 #include "City.h"
 #include "Unit.h"
 #include "HexMapRenderer.h"
+#include "FixedPointNoise.h"
+#include "HexMath.h"
 #include "Kismet/GameplayStatics.h"
+#include "Async/Async.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Misc/Crc.h"
+#include "Math/RandomStream.h"
 
 ACivi_GameModeBase::ACivi_GameModeBase()
 {
@@ -41,6 +48,7 @@ void ACivi_GameModeBase::BeginPlay()
         {
             // ȷȾ
             Renderer->RenderMap(MapGrid, MapWidth, MapHeight);
+            RenderedVisibilityPlayer = INDEX_NONE;
             break;
         }
     }
@@ -84,6 +92,9 @@ void ACivi_GameModeBase::StartTurn()
     // 1. λ (ָƶ)
     ProcessTurnStartForPlayer(CurrentPlayerIndex);
 
+    // δʹõ
+    FlowFields.AgeOut(CurrentTurn);
+
     // 2. ս (ֻʾǰҵҰ)
     UpdateFogOfWar();
 
@@ -93,15 +104,77 @@ void ACivi_GameModeBase::StartTurn()
 
 void ACivi_GameModeBase::ProcessTurnStartForPlayer(int32 PlayerIndex)
 {
-    // еλڸҵĵλ״̬
+    TRACE_CPUPROFILER_EVENT_SCOPE(ACivi_GameModeBase::ProcessTurnStartForPlayer);
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    // 1. еλڸҵĵλ״̬
+    TArray<AUnit*> Units;
     for (TActorIterator<AUnit> It(GetWorld()); It; ++It)
     {
         AUnit* Unit = *It;
         if (Unit && Unit->PlayerOwnerIndex == PlayerIndex)
         {
             Unit->OnTurnStart(); //  Unit ĻغϿʼ (ƶפػѪ)
+            Units.Add(Unit);
+        }
+    }
+
+    // 2. ³ (ѡѡ̽Ŀ)ռ·ʧЧĵλ
+    TArray<AUnit*> ReplanUnits;
+    TArray<FHexPathQuery> Queries;
+    for (AUnit* Unit : Units)
+    {
+        FHexPathQuery Query;
+        if (Unit->PrepareTurnOrder(Query))
+        {
+            ReplanUnits.Add(Unit);
+            Queries.Add(Query);
         }
     }
+    const double PrepareTime = FPlatformTime::Seconds();
+
+    // 3. ҪѰ·ĵλһύ߳
+    if (Queries.Num() > 0)
+    {
+        TArray<TFuture<FHexPathBatchResult>> Futures = SubmitPathBatch(Queries);
+        for (int32 i = 0; i < Futures.Num(); i++)
+        {
+            // Consume ȡ߽·ֱƶλǸ
+            FHexPathBatchResult Result = Futures[i].Consume();
+            ReplanUnits[i]->ApplyOrderPath(Result);
+        }
+    }
+    const double PathTime = FPlatformTime::Seconds();
+
+    // 4. ·ǰλסĵλλÿһ
+    int32 NumMoved = 0;
+    BeginMapChangeBatch();
+    for (int32 Pass = 0; Pass < 3; Pass++)
+    {
+        bool bAnyMoved = false;
+        for (AUnit* Unit : Units)
+        {
+            if (Unit->ExecuteOrderMove())
+            {
+                bAnyMoved = true;
+                NumMoved++;
+            }
+        }
+        if (!bAnyMoved) break;
+    }
+    EndMapChangeBatch();
+
+    // 5. Աλס·ΪʧЧ»غƿ赲Ѱ·
+    for (AUnit* Unit : Units)
+    {
+        Unit->MarkBlockedOrderPath();
+    }
+    const double EndTime = FPlatformTime::Seconds();
+
+    UE_LOG(LogTemp, Log, TEXT("Player %d turn start orders: %d units, %d replanned, %d moves. Prepare %.2f ms, paths %.2f ms, moves %.2f ms"),
+        PlayerIndex, Units.Num(), Queries.Num(), NumMoved,
+        (PrepareTime - StartTime) * 1000.0, (PathTime - PrepareTime) * 1000.0, (EndTime - PathTime) * 1000.0);
 }
 
 void ACivi_GameModeBase::ProcessTurnEndForPlayer(int32 PlayerIndex)
@@ -183,18 +256,48 @@ void ACivi_GameModeBase::AddPlayerResources(int32 PlayerIndex, const FYields& Yi
 
 void ACivi_GameModeBase::UpdateFogOfWar()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(ACivi_GameModeBase::UpdateFogOfWar);
+
     // ҵͼȾҰ
-    // 賡ֻһȾ
-    for (TActorIterator<AHexMapRenderer> It(GetWorld()); It; ++It)
+    AHexMapRenderer* Renderer = FindMapRenderer();
+    if (!Renderer) return;
+
+    if (RenderedVisibilityPlayer == CurrentPlayerIndex) return;
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    // ÿҵҰƽ泣פڴ棬лʱֻʾ״̬ͬĵؿ
+    const bool bCanDiff = RenderedVisibilityPlayer >= 0 && RenderedVisibilityPlayer < Visibility.GetNumPlayers()
+        && CurrentPlayerIndex >= 0 && CurrentPlayerIndex < Visibility.GetNumPlayers();
+
+    if (bCanDiff)
     {
-        AHexMapRenderer* Renderer = *It;
-        if (Renderer)
+        TArray<int32> Changed;
+        Visibility.GetDifferingTiles(RenderedVisibilityPlayer, CurrentPlayerIndex, Changed);
+        Renderer->UpdateTileVisibility(MapGrid, Changed, CurrentPlayerIndex);
+        LastVisibilitySwitchTiles = Changed.Num();
+
+        // һмĵؿ鰴ҵļʾ
+        TArray<int32> Remembered;
+        TileMemory.GetRememberedTiles(RenderedVisibilityPlayer, CurrentPlayerIndex, Remembered);
+        Renderer->SetTileMemory(&TileMemory, CurrentPlayerIndex);
+        for (int32 Index : Remembered)
         {
-            // ֮ǰʵֵº
-            Renderer->UpdateFogOfWarVisuals(MapGrid, CurrentPlayerIndex);
-            return;
+            Renderer->UpdateTile(MapGrid[Index]);
         }
     }
+    else
+    {
+        Renderer->SetTileMemory(&TileMemory, CurrentPlayerIndex);
+        Renderer->UpdateFogOfWarVisuals(MapGrid, CurrentPlayerIndex);
+        LastVisibilitySwitchTiles = MapGrid.Num();
+    }
+
+    RenderedVisibilityPlayer = CurrentPlayerIndex;
+    LastVisibilitySwitchSeconds = FPlatformTime::Seconds() - StartTime;
+
+    UE_LOG(LogTemp, Log, TEXT("Visibility switched to player %d: %d tiles in %.3f ms"),
+        CurrentPlayerIndex, LastVisibilitySwitchTiles, LastVisibilitySwitchSeconds * 1000.0);
 }
 
 void ACivi_GameModeBase::InitMap()
@@ -206,16 +309,119 @@ void ACivi_GameModeBase::InitMap()
     }
     FMath::SRandInit(MapSeed);
 
-    UE_LOG(LogTemp, Log, TEXT("Initializing map with seed: %d, Size: %dx%d"), MapSeed, MapWidth, MapHeight);
+    // ƫ X ҪΪż
+    if (MapWidth % 2 != 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MapWidth %d is odd; rounding up to %d so the horizontal wrap stays seamless"), MapWidth, MapWidth + 1);
+        MapWidth++;
+    }
 
-    // 2. ʼб
-    InitPermutation();
+    UE_LOG(LogTemp, Log, TEXT("Initializing map with seed: %d, Size: %dx%d"), MapSeed, MapWidth, MapHeight);
 
-    // 3. ղʼͼ
+    // 2. ղʼͼ
     MapGrid.Empty();
     MapGrid.SetNum(MapWidth * MapHeight);
 
-    // 4. ɸͼ
+    // 3. ȶȡ̻棬δʱɲд뻺
+    const FMapCacheKey CacheKey = MakeMapCacheKey();
+    if (!bUseMapCache || !LoadMapFromCache(CacheKey))
+    {
+        GenerateMapTiles();
+
+        if (bUseMapCache)
+        {
+            FMapCache::Save(CacheKey, MapGrid);
+        }
+    }
+
+    // 4. ھӹϵ
+    LinkNeighbors();
+
+    // 5. УͣڶԱȲͬϵɽ
+    MapChecksum = (int32)ComputeMapChecksum();
+
+    // 6. Ѱ·ʹõƶ
+    RebuildMovementCosts();
+
+    // 7. õλռ (λ֮ʱ)
+    UnitIndex.Reset(MapWidth, MapHeight);
+
+    // 8. Ұڵ (ɽꡢɭ) ÿҵҰƽ
+    Visibility.Init(MapWidth, MapHeight, TotalPlayers);
+    Visibility.BuildBlockers(MapGrid);
+    SightObservers.Reset();
+    TileMemory.Init(TotalPlayers);
+
+    UE_LOG(LogTemp, Log, TEXT("Map initialization complete. Total tiles: %d, Checksum: %08x"), MapGrid.Num(), (uint32)MapChecksum);
+}
+
+uint32 ACivi_GameModeBase::ComputeMapChecksum() const
+{
+    TArray<uint8> Bytes;
+    Bytes.Reserve(MapGrid.Num() * 4);
+
+    for (const ULandblock* Block : MapGrid)
+    {
+        Bytes.Add(Block ? (uint8)Block->Terrain : 0xFF);
+        Bytes.Add(Block ? (uint8)Block->Landform : 0xFF);
+        Bytes.Add(Block ? (uint8)Block->WonderType : 0xFF);
+        Bytes.Add(Block ? (uint8)Block->Resource : 0xFF);
+    }
+
+    return FCrc::MemCrc32(Bytes.GetData(), Bytes.Num());
+}
+
+FMapCacheKey ACivi_GameModeBase::MakeMapCacheKey() const
+{
+    FMapCacheKey Key;
+    Key.Seed = MapSeed;
+    Key.Width = MapWidth;
+    Key.Height = MapHeight;
+    Key.ElevationScale = ElevationScale;
+    Key.MoistureScale = MoistureScale;
+    Key.TemperatureScale = TemperatureScale;
+    Key.Octaves = Octaves;
+    Key.Persistence = Persistence;
+    Key.Lacunarity = Lacunarity;
+    Key.bFixedPointNoise = bUseFixedPointNoise;
+    Key.ResourceRulesHash = GlobalResourceData ? GlobalResourceData->GetPlacementRulesHash() : 0;
+    return Key;
+}
+
+bool ACivi_GameModeBase::LoadMapFromCache(const FMapCacheKey& Key)
+{
+    return FMapCache::Load(Key, [this](const FMapCacheTile* Tiles, int32 NumTiles)
+    {
+        for (int32 Index = 0; Index < NumTiles; Index++)
+        {
+            ULandblock* NewBlock = NewObject<ULandblock>(this, ULandblock::StaticClass());
+            NewBlock->X = Index % MapWidth;
+            NewBlock->Y = Index / MapWidth;
+            NewBlock->InitNeighbors();
+
+            NewBlock->Terrain = static_cast<ETerrain>(Tiles[Index].Terrain);
+            NewBlock->Landform = static_cast<ELandform>(Tiles[Index].Landform);
+            NewBlock->WonderType = static_cast<EWonderType>(Tiles[Index].Wonder);
+            NewBlock->Resource = static_cast<EResourceType>(Tiles[Index].Resource);
+
+            MapGrid[Index] = NewBlock;
+        }
+    });
+}
+
+void ACivi_GameModeBase::GenerateMapTiles()
+{
+    if (bUseFixedPointNoise)
+    {
+        GenerateMapTilesFixedPoint();
+        PlaceResources();
+        return;
+    }
+
+    // 1. ʼб
+    InitPermutation();
+
+    // 2. ɸͼ
     TArray<float> ElevationMap;
     TArray<float> MoistureMap;
     TArray<float> TemperatureMap;
@@ -224,7 +430,7 @@ void ACivi_GameModeBase::InitMap()
     GenerateMoistureMap(MoistureMap);
     GenerateTemperatureMap(TemperatureMap);
 
-    // 5. ؿ鲢/ò
+    // 3. ؿ鲢/ò
     for (int32 Y = 0; Y < MapHeight; Y++)
     {
         for (int32 X = 0; X < MapWidth; X++)
@@ -250,10 +456,8 @@ void ACivi_GameModeBase::InitMap()
         }
     }
 
-    // 6. ھӹϵ
-    LinkNeighbors();
-
-    UE_LOG(LogTemp, Log, TEXT("Map initialization complete. Total tiles: %d"), MapGrid.Num());
+    // 4. òȷԴ
+    PlaceResources();
 }
 
 //==============================
@@ -550,33 +754,304 @@ ELandform ACivi_GameModeBase::DetermineLandform(ETerrain Terrain, float Elevatio
 }
 
 //==============================
-// ھϵͳ
+// ͼ (λһ)
 //==============================
 
-void ACivi_GameModeBase::GetHexNeighborOffsets(int32 Y, TArray<FIntPoint>& OutOffsets) const
+void ACivi_GameModeBase::GenerateMapTilesFixedPoint()
 {
-    OutOffsets.SetNum(6);
+    constexpr int32 One = FFixedPointNoise::One;
+    constexpr int32 Shift = FFixedPointNoise::FracBits;
+
+    FFixedPointNoise Noise;
+    Noise.Init(MapSeed);
 
-    // ƫ˳: (0), (1), (2), (3), (4), (5)
-    // żкУεھƫƲͬ
+    // ͼƫ (0 ~ 10000Q16)
+    const uint32 OffsetRange = 10000u << FFixedPointNoise::CoordFracBits;
+    auto MakeOffset = [this, OffsetRange](uint32 Salt)
+    {
+        return (int32)(FFixedPointNoise::Hash((uint32)MapSeed, Salt, 0) % OffsetRange);
+    };
+
+    const int32 PersistenceQ12 = FFixedPointNoise::QuantizeQ12(Persistence);
+    const int32 LacunarityQ12 = FFixedPointNoise::QuantizeQ12(Lacunarity);
+
+    TArray<int32> ElevationMap;
+    TArray<int32> MoistureMap;
+    TArray<int32> TemperatureMap;
+
+    Noise.GenerateField(MapWidth, MapHeight, FFixedPointNoise::QuantizeQ16(ElevationScale), MakeOffset(1), MakeOffset(2),
+        Octaves, PersistenceQ12, LacunarityQ12, ElevationMap);
+    Noise.GenerateField(MapWidth, MapHeight, FFixedPointNoise::QuantizeQ16(MoistureScale), MakeOffset(3), MakeOffset(4),
+        Octaves - 1, PersistenceQ12, LacunarityQ12, MoistureMap);
+    Noise.GenerateField(MapWidth, MapHeight, FFixedPointNoise::QuantizeQ16(TemperatureScale), MakeOffset(5), MakeOffset(6),
+        2, FFixedPointNoise::ToFixed(0.5), FFixedPointNoise::ToFixed(2.0), TemperatureMap);
 
-    if (Y % 2 == 0) // ż
+    for (int32 Y = 0; Y < MapHeight; Y++)
     {
-        OutOffsets[0] = FIntPoint(0, -1);   // 
-        OutOffsets[1] = FIntPoint(1, 0);    // 
-        OutOffsets[2] = FIntPoint(0, 1);    // 
-        OutOffsets[3] = FIntPoint(-1, 1);   // 
-        OutOffsets[4] = FIntPoint(-1, 0);   // 
-        OutOffsets[5] = FIntPoint(-1, -1);  // 
+        // γ (ȣ)
+        const int32 DistY = FMath::Abs(Y * One / MapHeight - One / 2) * 2;
+        const int32 LatitudeFactor = One - DistY;
+        const int32 EdgeFactorY = One - ((DistY * DistY) >> Shift);
+
+        for (int32 X = 0; X < MapWidth; X++)
+        {
+            const int32 Index = GetIndex(X, Y);
+
+            // Ե - õͼԵǺ
+            const int32 DistX = FMath::Abs(X * One / MapWidth - One / 2) * 2;
+            const int32 EdgeFactorX = One - ((DistX * DistX) >> Shift);
+            const int32 EdgeFactor = (EdgeFactorX * EdgeFactorY) >> Shift;
+
+            int32 Elevation = (ElevationMap[Index] * FFixedPointNoise::ToFixed(0.7) + EdgeFactor * FFixedPointNoise::ToFixed(0.3)) >> Shift;
+            Elevation = FMath::Clamp(Elevation, 0, One);
+
+            const int32 Moisture = FMath::Clamp(MoistureMap[Index], 0, One);
+
+            int32 Temperature = ((LatitudeFactor * FFixedPointNoise::ToFixed(0.7)) >> Shift)
+                + ((TemperatureMap[Index] * FFixedPointNoise::ToFixed(0.3)) >> Shift)
+                + FFixedPointNoise::ToFixed(0.15);
+            Temperature = FMath::Clamp(Temperature, 0, One);
+
+            ULandblock* NewBlock = NewObject<ULandblock>(this, ULandblock::StaticClass());
+            NewBlock->X = X;
+            NewBlock->Y = Y;
+            NewBlock->InitNeighbors();
+
+            NewBlock->Terrain = DetermineTerrainFixed(Elevation, Moisture, Temperature);
+            NewBlock->Landform = DetermineLandformFixed(NewBlock->Terrain, Elevation, Moisture, Temperature, Index);
+
+            MapGrid[Index] = NewBlock;
+        }
     }
-    else // 
+}
+
+ETerrain ACivi_GameModeBase::DetermineTerrainFixed(int32 Elevation, int32 Moisture, int32 Temperature) const
+{
+    // ֵ븡 DetermineTerrain ͬ
+    if (Elevation < FFixedPointNoise::ToFixed(0.3)) return ETerrain::Ocean;
+    if (Elevation < FFixedPointNoise::ToFixed(0.4)) return ETerrain::Coast;
+
+    if (Temperature < FFixedPointNoise::ToFixed(0.15)) return ETerrain::Snow;
+    if (Temperature < FFixedPointNoise::ToFixed(0.3)) return ETerrain::Tundra;
+
+    if (Moisture < FFixedPointNoise::ToFixed(0.25) && Temperature > FFixedPointNoise::ToFixed(0.5)) return ETerrain::Desert;
+    if (Moisture < FFixedPointNoise::ToFixed(0.5)) return ETerrain::Grassland;
+
+    return ETerrain::Plain;
+}
+
+ELandform ACivi_GameModeBase::DetermineLandformFixed(ETerrain Terrain, int32 Elevation, int32 Moisture, int32 Temperature, int32 Index) const
+{
+    // жʹ (, ؿ, ;) Ĺϣ˳޹
+    auto Roll = [this, Index](uint32 Salt)
+    {
+        return (int32)(FFixedPointNoise::Hash((uint32)MapSeed, (uint32)Index, Salt) & (FFixedPointNoise::One - 1));
+    };
+
+    if (Terrain == ETerrain::Ocean || Terrain == ETerrain::Coast) return ELandform::None;
+
+    if (Elevation > FFixedPointNoise::ToFixed(0.85)) return ELandform::Mountain;
+    if (Elevation > FFixedPointNoise::ToFixed(0.7)) return ELandform::Hills;
+
+    if (Terrain == ETerrain::Snow && Roll(1) < FFixedPointNoise::ToFixed(0.3)) return ELandform::Ice;
+
+    if (Terrain == ETerrain::Desert && Moisture > FFixedPointNoise::ToFixed(0.3) && Roll(2) < FFixedPointNoise::ToFixed(0.05))
     {
-        OutOffsets[0] = FIntPoint(1, -1);   // 
-        OutOffsets[1] = FIntPoint(1, 0);    // 
-        OutOffsets[2] = FIntPoint(1, 1);    // 
-        OutOffsets[3] = FIntPoint(0, 1);    // 
-        OutOffsets[4] = FIntPoint(-1, 0);   // 
-        OutOffsets[5] = FIntPoint(0, -1);   // 
+        return ELandform::Oasis;
+    }
+
+    if (Moisture > FFixedPointNoise::ToFixed(0.6))
+    {
+        if (Temperature > FFixedPointNoise::ToFixed(0.7))
+        {
+            if (Roll(3) < FFixedPointNoise::ToFixed(0.6)) return ELandform::Rainforest;
+        }
+        else if (Temperature > FFixedPointNoise::ToFixed(0.35))
+        {
+            if (Roll(4) < FFixedPointNoise::ToFixed(0.5)) return ELandform::Forest;
+        }
+    }
+
+    if (Moisture > FFixedPointNoise::ToFixed(0.7) && Temperature > FFixedPointNoise::ToFixed(0.4) && Elevation < FFixedPointNoise::ToFixed(0.5))
+    {
+        if (Roll(5) < FFixedPointNoise::ToFixed(0.2)) return ELandform::Marsh;
+    }
+
+    if (Moisture > FFixedPointNoise::ToFixed(0.4) && Temperature > FFixedPointNoise::ToFixed(0.3) && Temperature < FFixedPointNoise::ToFixed(0.8))
+    {
+        if (Roll(6) < FFixedPointNoise::ToFixed(0.25)) return ELandform::Forest;
+    }
+
+    return ELandform::None;
+}
+
+//==============================
+// Դ (Բ̲ + οռϣ)
+//==============================
+
+void ACivi_GameModeBase::PlaceResources()
+{
+    if (!GlobalResourceData || GlobalResourceData->Resources.Num() == 0) return;
+
+    const int32 Radius = FMath::Max(1, GlobalResourceData->MinSpacing);
+    const int32 NumTiles = MapWidth * MapHeight;
+
+    //  (, ) ϣ֤һ
+    uint32 RandCounter = 0;
+    auto NextRand = [this, &RandCounter]()
+    {
+        return FFixedPointNoise::Hash((uint32)MapSeed, RandCounter++, 0x2E50u);
+    };
+    auto RandRange = [&NextRand](int32 Min, int32 Max)
+    {
+        return Min + (int32)(NextRand() % (uint32)(Max - Min + 1));
+    };
+
+    // 1. ǿԷԴĵؿ
+    TBitArray<> Eligible(false, NumTiles);
+    for (int32 Index = 0; Index < NumTiles; Index++)
+    {
+        const ULandblock* Block = MapGrid[Index];
+        if (Block && Block->WonderType == EWonderType::None && GlobalResourceData->HasResourceFor(Block->Terrain, Block->Landform))
+        {
+            Eligible[Index] = true;
+        }
+    }
+
+    // 2. ռϣԪ߳ڲ뾶 (MinSpacing)Сڰ뾶ĵһڵԪ
+    const int32 CellsX = FMath::DivideAndRoundUp(MapWidth, Radius);
+    const int32 CellsY = FMath::DivideAndRoundUp(MapHeight, Radius);
+    // ͼȲǰ뾶ʱƴһеԪխҪһ
+    const int32 CellReachX = (MapWidth % Radius == 0) ? 1 : 2;
+
+    TArray<TArray<int32, TInlineAllocator<4>>> Cells;
+    Cells.SetNum(CellsX * CellsY);
+
+    TArray<int32> Samples;
+    TArray<int32> ActiveList;
+
+    auto TryAddSample = [&](int32 X, int32 Y) -> bool
+    {
+        const int32 Index = GetIndex(X, Y);
+        if (!Eligible[Index]) return false;
+
+        const int32 CellX = X / Radius;
+        const int32 CellY = Y / Radius;
+        for (int32 DY = -1; DY <= 1; DY++)
+        {
+            const int32 CY = CellY + DY;
+            if (CY < 0 || CY >= CellsY) continue;
+
+            for (int32 DX = -CellReachX; DX <= CellReachX; DX++)
+            {
+                const int32 CX = FHexMath::WrapX(CellX + DX, CellsX);
+                for (int32 Other : Cells[CY * CellsX + CX])
+                {
+                    // ǡõ MinSpacing 
+                    if (FHexMath::Distance(X, Y, Other % MapWidth, Other / MapWidth, MapWidth) < Radius)
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        Cells[CellY * CellsX + CellX].Add(Index);
+        Samples.Add(Index);
+        ActiveList.Add(Index);
+        return true;
+    };
+
+    // 3. ÿԪͶһӵ㣬֤µͷɢĴ½Ҳܱ
+    const int32 SeedAttempts = 3;
+    for (int32 CellIndex = 0; CellIndex < Cells.Num(); CellIndex++)
+    {
+        const int32 MinX = (CellIndex % CellsX) * Radius;
+        const int32 MinY = (CellIndex / CellsX) * Radius;
+        const int32 MaxX = FMath::Min(MinX + Radius, MapWidth) - 1;
+        const int32 MaxY = FMath::Min(MinY + Radius, MapHeight) - 1;
+
+        for (int32 Attempt = 0; Attempt < SeedAttempts; Attempt++)
+        {
+            if (TryAddSample(RandRange(MinX, MaxX), RandRange(MinY, MaxY))) break;
+        }
+    }
+
+    // 4. Bridson չڻΧ [Radius, 2 * Radius) Ļڲ
+    const int32 CandidateAttempts = 12;
+    while (ActiveList.Num() > 0)
+    {
+        const int32 ActiveSlot = RandRange(0, ActiveList.Num() - 1);
+        const int32 Center = ActiveList[ActiveSlot];
+        const FIntPoint CenterAxial = FHexMath::OffsetToAxial(Center % MapWidth, Center / MapWidth);
+
+        bool bFound = false;
+        for (int32 Attempt = 0; Attempt < CandidateAttempts && !bFound; Attempt++)
+        {
+            const FIntPoint Candidate(CenterAxial.X + RandRange(-2 * Radius, 2 * Radius), CenterAxial.Y + RandRange(-2 * Radius, 2 * Radius));
+            const int32 Dist = FHexMath::AxialDistance(CenterAxial, Candidate);
+            if (Dist < Radius || Dist >= 2 * Radius) continue;
+
+            const FIntPoint Offset = FHexMath::AxialToOffset(Candidate.X, Candidate.Y);
+            if (Offset.Y < 0 || Offset.Y >= MapHeight) continue;
+
+            bFound = TryAddSample(FHexMath::WrapX(Offset.X, MapWidth), Offset.Y);
+        }
+
+        if (!bFound)
+        {
+            ActiveList.RemoveAtSwap(ActiveSlot);
+        }
+    }
+
+    // 5. ȨΪÿѡԴ
+    const uint32 ChanceQ16 = (uint32)FMath::Clamp(FMath::RoundToInt(GlobalResourceData->PlacementChance * 65536.0f), 0, 65536);
+    int32 NumPlaced = 0;
+
+    for (int32 Index : Samples)
+    {
+        if ((NextRand() & 0xFFFF) >= ChanceQ16) continue;
+
+        ULandblock* Block = MapGrid[Index];
+
+        int32 TotalWeight = 0;
+        for (const FResourceInfo& Info : GlobalResourceData->Resources)
+        {
+            if (Info.CanPlaceOn(Block->Terrain, Block->Landform)) TotalWeight += Info.Weight;
+        }
+        if (TotalWeight <= 0) continue;
+
+        int32 Pick = RandRange(0, TotalWeight - 1);
+        for (const FResourceInfo& Info : GlobalResourceData->Resources)
+        {
+            if (!Info.CanPlaceOn(Block->Terrain, Block->Landform)) continue;
+
+            Pick -= Info.Weight;
+            if (Pick < 0)
+            {
+                Block->Resource = Info.ResourceType;
+                NumPlaced++;
+                break;
+            }
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Resource placement: %d samples, %d resources placed (spacing %d)"), Samples.Num(), NumPlaced, Radius);
+}
+
+//==============================
+// ھϵͳ
+//==============================
+
+void ACivi_GameModeBase::GetHexNeighborOffsets(int32 X, TArray<FIntPoint>& OutOffsets) const
+{
+    OutOffsets.SetNum(6);
+
+    // ƫ˳: (0), (1), (2), (3), (4), (5)
+    // ƽưżкеھƫƲͬ ( FHexMath Ⱦһ)
+    for (int32 Dir = 0; Dir < 6; Dir++)
+    {
+        OutOffsets[Dir] = FIntPoint(FHexMath::NeighborOffsetX[Dir], FHexMath::NeighborOffsetY[X & 1][Dir]);
     }
 }
 
@@ -590,7 +1065,7 @@ void ACivi_GameModeBase::LinkNeighbors()
             if (!CurrentBlock) continue;
 
             TArray<FIntPoint> Offsets;
-            GetHexNeighborOffsets(Y, Offsets);
+            GetHexNeighborOffsets(X, Offsets);
 
             for (int32 Dir = 0; Dir < 6; Dir++)
             {
@@ -725,53 +1200,577 @@ bool ACivi_GameModeBase::IsTechUnlocked(int32 PlayerIndex, ETechType Tech) const
 
 ULandblock* ACivi_GameModeBase::GetLandblockFromWorldPos(FVector WorldPos)
 {
-    // 򵥵ѧ ( HexRadius = 100, HexGap = 2,  MapRenderer һ)
-    float R = 100.0f;
-    float W = R * 2.0f + 2.0f;
-    float H = R * FMath::Sqrt(3.0f) + 2.0f;
+    // Ⱦʵλռ䣬תȾľֲ
+    AHexMapRenderer* Renderer = FindMapRenderer();
+    if (Renderer)
+    {
+        WorldPos = Renderer->GetActorTransform().InverseTransformPosition(WorldPos);
+    }
 
-    //  GridY
-    float ApproxY = WorldPos.Y / H;
-    int32 Y = FMath::RoundToInt(ApproxY);
+    int32 X, Y;
+    if (!GetHexLayout().WorldToTile(WorldPos, MapWidth, MapHeight, X, Y)) return nullptr;
 
-    // ż X ƫ
-    float XOffset = 0.0f;
-    if (Y % 2 == 1) XOffset = W * 0.5f; // ƫư
+    return GetLandblock(X, Y);
+}
 
-    float ApproxX = (WorldPos.X - (XOffset * 0.75f)) / (W * 0.75f); // 0.75 Ϊˮƽص
-    int32 X = FMath::RoundToInt(WorldPos.X / (W * 0.75f));
+FHexLayout ACivi_GameModeBase::GetHexLayout()
+{
+    AHexMapRenderer* Renderer = FindMapRenderer();
+    return Renderer ? Renderer->GetLayout() : FHexLayout();
+}
 
-    // ע⣺ķǽֵ׼ʰȡҪӵѧ (Axial Coordinates)
-    // ԭͣǿԱΧģʹü򵥵ľ
+FVector ACivi_GameModeBase::GetTileWorldPosition(int32 X, int32 Y)
+{
+    AHexMapRenderer* Renderer = FindMapRenderer();
+    if (!Renderer) return FHexLayout().TileToWorld(X, Y);
 
-    ULandblock* BestBlock = nullptr;
-    float MinDistSq = FLT_MAX;
+    return Renderer->GetActorTransform().TransformPosition(Renderer->GetLayout().TileToWorld(X, Y));
+}
 
-    // λøĸ (ͼ̫򵥴ȫͼֲ)
-    // Żֻ X,Y  3x3 Χ
-    // Ϊʾֱ࣬ü߼
+AHexMapRenderer* ACivi_GameModeBase::FindMapRenderer()
+{
+    if (!CachedMapRenderer.IsValid())
+    {
+        // 賡ֻһȾ
+        TActorIterator<AHexMapRenderer> It(GetWorld());
+        CachedMapRenderer = It ? *It : nullptr;
+    }
+    return CachedMapRenderer.Get();
+}
 
-    // Ǽ RenderMap ʱλãﷴұȽ鷳
-    // 򵥵ķֱӱ LandblockҾ WorldPos Ҿ < R Ǹ
+//==============================
+// Ѱ·
+//==============================
 
-    for (ULandblock* Block : MapGrid)
+void ACivi_GameModeBase::RebuildMovementCosts()
+{
+    MovementCosts.Build(MapGrid, MapWidth, MapHeight, GlobalTerrainData);
+    MovementCostVersion++;
+    PathHierarchy.Build(MovementCosts);
+    PathCache.Reset(MapWidth, MapHeight);
+    FlowFields.Reset();
+
+    // µǼоµλĿ
+    MovementCosts.EnsureZoneOfControlPlayers(TotalPlayers);
+    for (TActorIterator<AUnit> It(GetWorld()); It; ++It)
     {
-        if (!Block) continue;
+        AUnit* Unit = *It;
+        if (Unit && Unit->CurrentBlock && Unit->ExertsZoneOfControl())
+        {
+            MovementCosts.UpdateZoneOfControl(Unit->PlayerOwnerIndex, GetIndex(Unit->GridX, Unit->GridY), 1);
+        }
+    }
 
-        // ¼ Block λ (븴 HexMapRenderer Ĺʽ)
-        float WorldX = Block->X * W * 0.75f;
-        float WorldY = Block->Y * H;
-        if (Block->X % 2 == 1) WorldY += H * 0.5f;
+    MovementCosts.Landmarks.Reset();
+    RequestLandmarkRebuild();
+}
+
+void ACivi_GameModeBase::BenchmarkPathfinding(int32 Width, int32 Height, int32 NumQueries)
+{
+    if (Width <= 0) Width = 512;
+    if (Height <= 0) Height = 512;
+    if (NumQueries <= 0) NumQueries = 1000;
+
+    // ǰϷͼ
+    FHexPathfinder::RunBenchmarkOnGrid(MovementCosts, NumQueries, MapSeed, TEXT("CurrentMap"));
+
+    // ͼ
+    FHexPathfinder::RunBenchmark(Width, Height, NumQueries, MapSeed);
+}
+
+FHexPathResult ACivi_GameModeBase::FindPathCached(const FHexPathQuery& Query, TArray<int32>& OutPath)
+{
+    return PathCache.FindPath(MovementCosts, Query, OutPath);
+}
+
+void ACivi_GameModeBase::DumpPathCacheStats()
+{
+    PathCache.LogStats();
+}
+
+TSharedRef<const FHexFlowField> ACivi_GameModeBase::GetFlowField(TConstArrayView<int32> TargetIndices, int32 MaxMovementPoints, EMovementClass MovementClass)
+{
+    return FlowFields.FindOrBuild(MovementCosts, TargetIndices, MaxMovementPoints, MovementClass, CurrentTurn);
+}
+
+TSharedRef<const FMovementCostGrid> ACivi_GameModeBase::MakeMovementCostSnapshot() const
+{
+    return MakeShared<FMovementCostGrid>(MovementCosts);
+}
+
+TArray<TFuture<FHexPathBatchResult>> ACivi_GameModeBase::SubmitPathBatch(const TArray<FHexPathQuery>& Queries)
+{
+    return FHexPathBatch::Submit(MakeMovementCostSnapshot(), Queries);
+}
+
+void ACivi_GameModeBase::BenchmarkPathBatch(int32 Width, int32 Height, int32 NumQueries)
+{
+    if (Width <= 0) Width = 512;
+    if (Height <= 0) Height = 512;
+    if (NumQueries <= 0) NumQueries = 2000;
+
+    TSharedRef<FMovementCostGrid> Grid = MakeShared<FMovementCostGrid>();
+    FHexPathfinder::MakeRandomGrid(Width, Height, MapSeed, *Grid);
+
+    FHexPathBatch::RunBenchmark(Grid, NumQueries, MapSeed);
+}
+
+bool ACivi_GameModeBase::FindHierarchicalPath(int32 StartIndex, int32 GoalIndex, int32 MaxMovementPoints, FHexHierarchicalPath& OutPath)
+{
+    return PathHierarchy.FindPath(MovementCosts, StartIndex, GoalIndex, MaxMovementPoints, OutPath);
+}
+
+void ACivi_GameModeBase::BenchmarkHierarchicalPathfinding(int32 Width, int32 Height, int32 NumQueries)
+{
+    if (Width <= 0) Width = 2048;
+    if (Height <= 0) Height = 1024;
+    if (NumQueries <= 0) NumQueries = 50;
+
+    FHexHierarchicalPathfinder::RunBenchmark(Width, Height, NumQueries, MapSeed);
+}
+
+void ACivi_GameModeBase::RequestLandmarkRebuild()
+{
+    LandmarkVersion++;
+
+    // йڽУʱְ汾ڻԶ¿ʼ
+    if (!bLandmarkBuildInFlight)
+    {
+        StartLandmarkBuild();
+    }
+}
+
+void ACivi_GameModeBase::StartLandmarkBuild()
+{
+    if (!MovementCosts.IsValid()) return;
+
+    bLandmarkBuildInFlight = true;
+
+    const uint32 Version = LandmarkVersion;
+    TSharedRef<const FMovementCostGrid> Snapshot = MakeMovementCostSnapshot();
+    TWeakObjectPtr<ACivi_GameModeBase> WeakThis(this);
+
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Snapshot, Version, WeakThis]()
+    {
+        TSharedRef<FHexLandmarkTable> Table = MakeShared<FHexLandmarkTable>();
+        Table->Build(*Snapshot);
+
+        AsyncTask(ENamedThreads::GameThread, [Table, Version, WeakThis]()
+        {
+            if (ACivi_GameModeBase* GameMode = WeakThis.Get())
+            {
+                GameMode->OnLandmarksBuilt(Table, Version);
+            }
+        });
+    });
+}
+
+void ACivi_GameModeBase::OnLandmarksBuilt(const TSharedRef<const FHexLandmarkTable>& Table, uint32 Version)
+{
+    bLandmarkBuildInFlight = false;
+
+    // ڼַ˱仯ɱܸ߹
+    if (Version != LandmarkVersion)
+    {
+        StartLandmarkBuild();
+        return;
+    }
+
+    MovementCosts.Landmarks = Table;
+}
+
+void ACivi_GameModeBase::BenchmarkLandmarks(int32 Width, int32 Height, int32 NumQueries)
+{
+    if (Width <= 0) Width = 1024;
+    if (Height <= 0) Height = 512;
+    if (NumQueries <= 0) NumQueries = 200;
+
+    // ǰϷͼ
+    FHexLandmarkTable::RunBenchmarkOnGrid(MovementCosts, NumQueries, MapSeed, TEXT("CurrentMap"));
+
+    // ͼ
+    FMovementCostGrid Grid;
+    FHexPathfinder::MakeRandomGrid(Width, Height, MapSeed, Grid);
+    FHexLandmarkTable::RunBenchmarkOnGrid(Grid, NumQueries, MapSeed, TEXT("Random"));
+}
+
+void ACivi_GameModeBase::BenchmarkRenderPrep(int32 NumRuns)
+{
+    AHexMapRenderer* Renderer = FindMapRenderer();
+    if (!Renderer) return;
+    if (NumRuns <= 0) NumRuns = 10;
+
+    // С׼󡢾޴ͼԼѹԵͼ
+    const FIntPoint Sizes[] = { {74, 46}, {84, 54}, {96, 60}, {106, 66}, {128, 80}, {256, 256}, {512, 512} };
+
+    // ؿʱУ֪ͨϷģʽֻڵһεʱߴ紴Ѵ UObject ķͻռ
+    const int32 MaxTiles = Sizes[UE_ARRAY_COUNT(Sizes) - 1].X * Sizes[UE_ARRAY_COUNT(Sizes) - 1].Y;
+    while (BenchmarkGrid.Num() < MaxTiles)
+    {
+        BenchmarkGrid.Add(NewObject<ULandblock>(GetTransientPackage()));
+    }
+
+    // Ⱦ׼ֻȡͣͬཨһ
+    const int32 NumBuildingTypes = (int32)EBuildingType::Pasture + 1;
+    while (BenchmarkBuildings.Num() < NumBuildingTypes)
+    {
+        UBuilding* Building = NewObject<UBuilding>(GetTransientPackage());
+        Building->Type = static_cast<EBuildingType>(BenchmarkBuildings.Num());
+        BenchmarkBuildings.Add(Building);
+    }
+
+    FRandomStream Random(MapSeed);
+    TArray<ULandblock*> Grid;
+    for (const FIntPoint& Size : Sizes)
+    {
+        const int32 NumTiles = Size.X * Size.Y;
+        Grid.Reset(NumTiles);
+        Grid.Append(BenchmarkGrid.GetData(), NumTiles);
+
+        for (int32 Index = 0; Index < NumTiles; Index++)
+        {
+            ULandblock* Block = Grid[Index];
+            Block->X = Index % Size.X;
+            Block->Y = Index / Size.X;
+            Block->Terrain = static_cast<ETerrain>(Random.RandRange(0, (int32)ETerrain::Snow));
+            Block->Landform = Random.FRand() < 0.4f ? static_cast<ELandform>(Random.RandRange(1, (int32)ELandform::Ice)) : ELandform::None;
+            Block->Building = Random.FRand() < 0.05f ? BenchmarkBuildings[Random.RandRange(1, (int32)EBuildingType::Pasture)] : nullptr;
+        }
+
+        Renderer->RunRenderPrepBenchmark(Grid, Size.X, Size.Y, NumRuns);
+    }
+}
+
+void ACivi_GameModeBase::OnTileOccupancyChanged(ULandblock* Block)
+{
+    if (!Block) return;
+
+    const int32 Index = GetIndex(Block->X, Block->Y);
+    if (bMapChangeBatchActive)
+    {
+        BatchedOccupancyChanges.Add(Index);
+        return;
+    }
+
+    MovementCosts.SetOccupied(Index, Block->HasUnit());
+    RecordMapChange(Index);
+}
+
+void ACivi_GameModeBase::BeginMapChangeBatch()
+{
+    bMapChangeBatchActive = true;
+}
+
+void ACivi_GameModeBase::EndMapChangeBatch()
+{
+    bMapChangeBatchActive = false;
+
+    for (int32 Index : BatchedOccupancyChanges)
+    {
+        if (MapGrid.IsValidIndex(Index) && MapGrid[Index])
+        {
+            MovementCosts.SetOccupied(Index, MapGrid[Index]->HasUnit());
+            RecordMapChange(Index);
+        }
+    }
+    BatchedOccupancyChanges.Reset();
+}
+
+void ACivi_GameModeBase::NotifyTileTerrainChanged(ULandblock* Block)
+{
+    if (!Block || !MovementCosts.IsValid()) return;
+
+    const int32 Index = GetIndex(Block->X, Block->Y);
+    MovementCostVersion++;
+    if (MovementCosts.UpdateTile(Index, Block, GlobalTerrainData))
+    {
+        // ͨԸıͨж
+        MovementCosts.BuildComponents();
+    }
+    PathHierarchy.MarkTileDirty(Index);
+    PathCache.InvalidateTile(Index);
+    FlowFields.Reset();
+    RecordMapChange(Index);
+
+    Visibility.UpdateBlocker(Index, Block);
+    RefreshSightNear(Index);
+
+    RefreshTileVisuals(Block);
+
+    // ɵĵرܸ߹ؽǰʹ
+    MovementCosts.Landmarks.Reset();
+    RequestLandmarkRebuild();
+}
+
+TArray<AUnit*> ACivi_GameModeBase::GetUnitsInRadius(int32 PlayerIndex, int32 X, int32 Y, int32 Radius) const
+{
+    TArray<AUnit*> Units;
+    UnitIndex.GetUnitsInRadius(PlayerIndex, X, Y, Radius, Units);
+    return Units;
+}
+
+AUnit* ACivi_GameModeBase::FindNearestEnemyUnit(int32 PlayerIndex, int32 X, int32 Y, int32 MaxRadius) const
+{
+    return UnitIndex.FindNearestEnemy(PlayerIndex, X, Y, MaxRadius);
+}
+
+AUnit* ACivi_GameModeBase::FindNextUnitNeedingOrders(int32 PlayerIndex, AUnit* After) const
+{
+    AUnit* First = nullptr;
+    bool bPassedAfter = After == nullptr;
+    for (TActorIterator<AUnit> It(GetWorld()); It; ++It)
+    {
+        AUnit* Unit = *It;
+        if (!Unit || Unit->PlayerOwnerIndex != PlayerIndex) continue;
+
+        if (Unit == After)
+        {
+            bPassedAfter = true;
+            continue;
+        }
+        if (!Unit->NeedsOrders()) continue;
+
+        if (bPassedAfter) return Unit;
+        if (!First) First = Unit;
+    }
+    return First;
+}
+
+void ACivi_GameModeBase::UpdateZoneOfControl(int32 OwnerPlayer, int32 X, int32 Y, int32 Delta)
+{
+    if (!MovementCosts.IsValid() || X < 0 || X >= MapWidth || Y < 0 || Y >= MapHeight) return;
+
+    const int32 Index = GetIndex(X, Y);
+    MovementCosts.UpdateZoneOfControl(OwnerPlayer, Index, Delta);
+
+    // ЩؿĻ·ܲ
+    PathCache.InvalidateTile(Index);
+    for (int32 Dir = 0; Dir < 6; Dir++)
+    {
+        const int32 Neighbor = FHexMath::GetNeighborIndex(X, Y, Dir, MapWidth, MapHeight);
+        if (Neighbor != INDEX_NONE)
+        {
+            PathCache.InvalidateTile(Neighbor);
+        }
+    }
+}
+
+void ACivi_GameModeBase::UpdateSightObserver(AActor* Observer, int32 PlayerIndex, int32 X, int32 Y, int32 Radius)
+{
+    if (!Observer || !Visibility.IsValid() || X < 0 || X >= MapWidth || Y < 0 || Y >= MapHeight) return;
+
+    FHexSightObserver NewSight;
+    NewSight.Player = PlayerIndex;
+    NewSight.X = X;
+    NewSight.Y = Y;
+    NewSight.Radius = Radius;
+    Visibility.ComputeSight(X, Y, Radius, NewSight.Mask);
+
+    TArray<int32> Changed;
+    FHexSightObserver* OldSight = SightObservers.Find(Observer);
+    if (OldSight && OldSight->Player == PlayerIndex)
+    {
+        Visibility.MoveSight(PlayerIndex, OldSight->X, OldSight->Y, OldSight->Mask, X, Y, NewSight.Mask, Changed);
+        ApplyVisibilityChanges(PlayerIndex, Changed);
+    }
+    else
+    {
+        // ԭҵҰг
+        if (OldSight)
+        {
+            Visibility.RemoveSight(OldSight->Player, OldSight->X, OldSight->Y, OldSight->Mask, Changed);
+            ApplyVisibilityChanges(OldSight->Player, Changed);
+            Changed.Reset();
+        }
+
+        Visibility.AddSight(PlayerIndex, X, Y, NewSight.Mask, Changed);
+        ApplyVisibilityChanges(PlayerIndex, Changed);
+    }
+
+    SightObservers.Add(Observer, NewSight);
+}
+
+void ACivi_GameModeBase::RemoveSightObserver(AActor* Observer)
+{
+    FHexSightObserver OldSight;
+    if (!SightObservers.RemoveAndCopyValue(Observer, OldSight)) return;
+
+    TArray<int32> Changed;
+    Visibility.RemoveSight(OldSight.Player, OldSight.X, OldSight.Y, OldSight.Mask, Changed);
+    ApplyVisibilityChanges(OldSight.Player, Changed);
+}
+
+void ACivi_GameModeBase::ApplyVisibilityChanges(int32 PlayerIndex, const TArray<int32>& ChangedTiles)
+{
+    if (ChangedTiles.Num() == 0) return;
 
-        float DistSq = FVector::DistSquared2D(WorldPos, FVector(WorldX, WorldY, 0));
-        if (DistSq < (R * R) && DistSq < MinDistSq)
+    // ½Ұĵؿ鲻Ҫ
+    TArray<int32> Forgotten;
+    for (int32 Index : ChangedTiles)
+    {
+        if (MapGrid.IsValidIndex(Index) && MapGrid[Index])
         {
-            MinDistSq = DistSq;
-            BestBlock = Block;
+            const EVisibilityState State = Visibility.GetState(PlayerIndex, Index);
+            MapGrid[Index]->SetVisibility(PlayerIndex, State);
+
+            if (State == EVisibilityState::Visible && TileMemory.Forget(PlayerIndex, Index))
+            {
+                Forgotten.Add(Index);
+            }
         }
     }
 
-    return BestBlock;
+    // ֻȾʾңҵı仯лʱͨλƽ첹
+    if (PlayerIndex == RenderedVisibilityPlayer)
+    {
+        if (AHexMapRenderer* Renderer = FindMapRenderer())
+        {
+            Renderer->UpdateTileVisibility(MapGrid, ChangedTiles, PlayerIndex);
+            for (int32 Index : Forgotten)
+            {
+                Renderer->UpdateTile(MapGrid[Index]);
+            }
+        }
+    }
+}
+
+void ACivi_GameModeBase::NotifyTileStateChanging(ULandblock* Block)
+{
+    if (!Block || !Visibility.IsValid()) return;
+
+    const int32 Index = Block->Y * MapWidth + Block->X;
+    if (!MapGrid.IsValidIndex(Index)) return;
+
+    TileMemory.RecordBeforeChange(Index, FHexTileSnapshot::Capture(Block), Visibility);
+}
+
+void ACivi_GameModeBase::RefreshTileVisuals(ULandblock* Block)
+{
+    if (AHexMapRenderer* Renderer = FindMapRenderer())
+    {
+        Renderer->UpdateTile(Block);
+    }
+}
+
+FHexTileSnapshot ACivi_GameModeBase::GetTileAsSeenBy(int32 PlayerIndex, const ULandblock* Block) const
+{
+    if (!Block) return FHexTileSnapshot();
+    return TileMemory.GetSeen(PlayerIndex, Block->Y * MapWidth + Block->X, Block, Visibility);
+}
+
+void ACivi_GameModeBase::RefreshSightNear(int32 TileIndex)
+{
+    const int32 TileX = TileIndex % MapWidth;
+    const int32 TileY = TileIndex / MapWidth;
+
+    // ռٸ£ʱ޸Ĺ۲߱
+    TArray<TPair<AActor*, FHexSightObserver>> Affected;
+    for (const TPair<TObjectKey<AActor>, FHexSightObserver>& Pair : SightObservers)
+    {
+        const FHexSightObserver& Sight = Pair.Value;
+        AActor* Observer = Pair.Key.ResolveObjectPtr();
+        if (Observer && FHexMath::Distance(Sight.X, Sight.Y, TileX, TileY, MapWidth) <= Sight.Radius)
+        {
+            Affected.Emplace(Observer, Sight);
+        }
+    }
+
+    for (const TPair<AActor*, FHexSightObserver>& Pair : Affected)
+    {
+        UpdateSightObserver(Pair.Key, Pair.Value.Player, Pair.Value.X, Pair.Value.Y, Pair.Value.Radius);
+    }
+}
+
+void ACivi_GameModeBase::RecomputeVisibility(int32 PlayerIndex)
+{
+    if (!Visibility.IsValid() || PlayerIndex < 0 || PlayerIndex >= Visibility.GetNumPlayers()) return;
+
+    Visibility.ResetPlayer(PlayerIndex);
+
+    TArray<int32> Changed;
+    for (TPair<TObjectKey<AActor>, FHexSightObserver>& Pair : SightObservers)
+    {
+        FHexSightObserver& Sight = Pair.Value;
+        if (Sight.Player == PlayerIndex)
+        {
+            Visibility.ComputeSight(Sight.X, Sight.Y, Sight.Radius, Sight.Mask);
+            Visibility.AddSight(PlayerIndex, Sight.X, Sight.Y, Sight.Mask, Changed);
+        }
+    }
+
+    // дصؿ (Ⱦ HUD ȡؿϵҰ״̬)״̬ıĵؿ
+    TArray<int32> ChangedTiles;
+    for (int32 Index = 0; Index < MapGrid.Num(); Index++)
+    {
+        if (ULandblock* Block = MapGrid[Index])
+        {
+            const EVisibilityState State = Visibility.GetState(PlayerIndex, Index);
+            if (Block->GetVisibility(PlayerIndex) != State)
+            {
+                Block->SetVisibility(PlayerIndex, State);
+                ChangedTiles.Add(Index);
+            }
+        }
+    }
+
+    TArray<int32> Forgotten;
+    TileMemory.ForgetVisible(PlayerIndex, Visibility, Forgotten);
+
+    // Ⱦʾң״̬ıغͼ䱻ĵؿ
+    // ͺȾҵλƽ汣һ£лԿ߲·
+    if (PlayerIndex == RenderedVisibilityPlayer)
+    {
+        if (AHexMapRenderer* Renderer = FindMapRenderer())
+        {
+            Renderer->UpdateTileVisibility(MapGrid, ChangedTiles, PlayerIndex);
+            for (int32 Index : Forgotten)
+            {
+                Renderer->UpdateTile(MapGrid[Index]);
+            }
+        }
+    }
+
+    if (PlayerIndex == CurrentPlayerIndex)
+    {
+        UpdateFogOfWar();
+    }
+}
+
+bool ACivi_GameModeBase::IsInEnemyZoneOfControl(int32 PlayerIndex, int32 X, int32 Y) const
+{
+    if (!MovementCosts.IsValid() || X < 0 || X >= MapWidth || Y < 0 || Y >= MapHeight) return false;
+
+    return MovementCosts.IsInZoneOfControl(PlayerIndex, GetIndex(X, Y));
+}
+
+void ACivi_GameModeBase::RecordMapChange(int32 TileIndex)
+{
+    if (MapChangeJournal.Num() >= MaxMapChangeJournal)
+    {
+        const int32 NumDropped = MapChangeJournal.Num() / 2;
+        MapChangeJournal.RemoveAt(0, NumDropped, EAllowShrinking::No);
+        MapChangeBaseSerial += NumDropped;
+    }
+
+    MapChangeJournal.Add(TileIndex);
+}
+
+bool ACivi_GameModeBase::HasMapChangedNear(uint64 Serial, int32 OriginIndex, int32 Radius) const
+{
+    if (Serial < MapChangeBaseSerial) return true;
+
+    const int32 OriginX = OriginIndex % MapWidth;
+    const int32 OriginY = OriginIndex / MapWidth;
+
+    for (int32 i = (int32)(Serial - MapChangeBaseSerial); i < MapChangeJournal.Num(); i++)
+    {
+        const int32 Changed = MapChangeJournal[i];
+        if (FHexMath::Distance(OriginX, OriginY, Changed % MapWidth, Changed / MapWidth, MapWidth) <= Radius)
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
 void ACivi_GameModeBase::CheckVictoryConditions()
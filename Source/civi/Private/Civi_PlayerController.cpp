@@ -6,6 +6,7 @@
 #include "Unit.h"
 #include "City.h"
 #include "Landblock.h"
+#include "HexMapRenderer.h"
 #include "Kismet/GameplayStatics.h"
 
 ACivi_PlayerController::ACivi_PlayerController()
@@ -150,6 +151,7 @@ void ACivi_PlayerController::HandleUnitMovement(ULandblock* TargetBlock)
         {
             // ƶˢUI
             if (HUDInstance) HUDInstance->UpdateUnitPanel(SelectedUnit, true);
+            ShowMovementRange(SelectedUnit);
         }
         else if (TargetBlock->HasUnit() && TargetBlock->OccupyingUnit != SelectedUnit)
         {
@@ -166,6 +168,7 @@ void ACivi_PlayerController::SelectUnit(AUnit* Unit)
 
     // UI 
     if (HUDInstance) HUDInstance->UpdateUnitPanel(SelectedUnit, true);
+    ShowMovementRange(SelectedUnit);
     UE_LOG(LogTemp, Log, TEXT("Selected Unit: %s"), *Unit->GetName());
 }
 
@@ -183,7 +186,15 @@ void ACivi_PlayerController::SelectTile(ULandblock* Block)
     ClearSelection();
     if (HUDInstance && Block)
     {
+        // ͨȡй¶ҿı仯
+        FHexTileSnapshot Seen = FHexTileSnapshot::Capture(Block);
+        if (ACivi_GameModeBase* GM = Cast<ACivi_GameModeBase>(GetWorld()->GetAuthGameMode()))
+        {
+            Seen = GM->GetTileAsSeenBy(GM->CurrentPlayerIndex, Block);
+        }
+
         HUDInstance->UpdateTilePanel(Block->Terrain, Block->Landform, true);
+        HUDInstance->UpdateTilePanelSeen(Seen.Building, Seen.OwnerPlayer, Seen.bHasCity, true);
     }
 }
 
@@ -191,19 +202,52 @@ void ACivi_PlayerController::ClearSelection()
 {
     SelectedUnit = nullptr;
     SelectedCity = nullptr;
+    ShowMovementRange(nullptr);
 
     if (HUDInstance)
     {
         HUDInstance->UpdateUnitPanel(nullptr, false);
         HUDInstance->UpdateCityPanel(nullptr, false);
         HUDInstance->UpdateTilePanel(ETerrain::Plain, ELandform::None, false);
+        HUDInstance->UpdateTilePanelSeen(EBuildingType::None, INDEX_NONE, false, false);
+    }
+}
+
+void ACivi_PlayerController::ShowMovementRange(AUnit* Unit)
+{
+    // ʹϷģʽȾ
+    ACivi_GameModeBase* GM = Cast<ACivi_GameModeBase>(GetWorld()->GetAuthGameMode());
+    AHexMapRenderer* Renderer = GM ? GM->FindMapRenderer() : nullptr;
+    if (!Renderer) return;
+
+    if (!Unit)
+    {
+        Renderer->ClearMovementRange();
+        return;
     }
+
+    // ƶΧλ棬ظѡͬһλ
+    const FHexReachableSet& Reachable = Unit->GetReachableTiles();
+
+    TArray<int32> TileIndices;
+    TileIndices.Reserve(Reachable.Tiles.Num());
+    for (const FReachableTile& Tile : Reachable.Tiles)
+    {
+        if (Tile.Index != Reachable.OriginIndex)
+        {
+            TileIndices.Add(Tile.Index);
+        }
+    }
+
+    Renderer->ShowMovementRange(TileIndices);
 }
 
 void ACivi_PlayerController::ExecuteUnitAction(int32 ActionID)
 {
     if (!SelectedUnit) return;
 
+    AUnit* Unit = SelectedUnit;
+
     switch (ActionID)
     {
         case 1: // פ
@@ -215,8 +259,41 @@ void ACivi_PlayerController::ExecuteUnitAction(int32 ActionID)
             ClearSelection();
             break;
         case 3: // /
-            // SelectedUnit->Sleep();
+            SelectedUnit->Sleep();
             ClearSelection();
             break;
+        case 4: // 
+            SelectedUnit->Alert();
+            ClearSelection();
+            break;
+        case 5: // Զ̽
+            SelectedUnit->AutoExplore();
+            ClearSelection();
+            break;
+        case 6: // פȬ
+            SelectedUnit->FortifyUntilHealed();
+            ClearSelection();
+            break;
+        default:
+            return;
+    }
+
+    // ´ֵָһλ
+    SelectNextUnitNeedingOrders(Unit);
+}
+
+void ACivi_PlayerController::SelectNextUnit()
+{
+    SelectNextUnitNeedingOrders(SelectedUnit);
+}
+
+void ACivi_PlayerController::SelectNextUnitNeedingOrders(AUnit* After)
+{
+    ACivi_GameModeBase* GM = Cast<ACivi_GameModeBase>(GetWorld()->GetAuthGameMode());
+    if (!GM) return;
+
+    if (AUnit* Next = GM->FindNextUnitNeedingOrders(GM->CurrentPlayerIndex, After))
+    {
+        SelectUnit(Next);
     }
 }
\ No newline at end of file
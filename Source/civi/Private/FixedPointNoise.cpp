@@ -0,0 +1,183 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FixedPointNoise.h"
+
+namespace
+{
+    // ݶȱ븡 Grad() ͬ 4 д Gx * X + Gy * Y ʽ
+    constexpr int32 GradX[4] = { 1, -1, -2, -2 };
+    constexpr int32 GradY[4] = { 2, 2, 1, -1 };
+
+    // 6t^5 - 15t^4 + 10t^3мֵ int32 Χ
+    FORCEINLINE VectorRegister4Int FixedFade4(const VectorRegister4Int& T)
+    {
+        const int32 Shift = FFixedPointNoise::FracBits;
+
+        VectorRegister4Int T2 = VectorShiftRightImmArithmetic(VectorIntMultiply(T, T), Shift);
+        VectorRegister4Int T3 = VectorShiftRightImmArithmetic(VectorIntMultiply(T2, T), Shift);
+
+        VectorRegister4Int Inner = VectorIntSubtract(VectorIntMultiply(T, VectorIntSet1(6)), VectorIntSet1(FFixedPointNoise::ToFixed(15.0)));
+        Inner = VectorShiftRightImmArithmetic(VectorIntMultiply(T, Inner), Shift);
+        Inner = VectorIntAdd(Inner, VectorIntSet1(FFixedPointNoise::ToFixed(10.0)));
+
+        return VectorShiftRightImmArithmetic(VectorIntMultiply(T3, Inner), Shift);
+    }
+
+    FORCEINLINE VectorRegister4Int FixedLerp4(const VectorRegister4Int& A, const VectorRegister4Int& B, const VectorRegister4Int& T)
+    {
+        return VectorIntAdd(A, VectorShiftRightImmArithmetic(VectorIntMultiply(T, VectorIntSubtract(B, A)), FFixedPointNoise::FracBits));
+    }
+
+    FORCEINLINE VectorRegister4Int FixedGrad4(const int32* Gx, const int32* Gy, const VectorRegister4Int& X, const VectorRegister4Int& Y)
+    {
+        return VectorIntAdd(VectorIntMultiply(VectorIntLoadAligned(Gx), X), VectorIntMultiply(VectorIntLoadAligned(Gy), Y));
+    }
+}
+
+uint32 FFixedPointNoise::Hash(uint32 A, uint32 B, uint32 C)
+{
+    uint32 H = A * 0x9E3779B1u;
+    H ^= B + 0x7F4A7C15u + (H << 6) + (H >> 2);
+    H ^= C + 0x85EBCA6Bu + (H << 6) + (H >> 2);
+
+    // murmur3 β
+    H ^= H >> 16;
+    H *= 0x85EBCA6Bu;
+    H ^= H >> 13;
+    H *= 0xC2B2AE35u;
+    H ^= H >> 16;
+    return H;
+}
+
+void FFixedPointNoise::Init(int32 Seed)
+{
+    int32 P[256];
+    for (int32 i = 0; i < 256; i++)
+    {
+        P[i] = i;
+    }
+
+    // Fisher-Yates ϴ (ϣȫ״̬)
+    for (int32 i = 255; i > 0; i--)
+    {
+        const int32 j = (int32)(Hash((uint32)Seed, (uint32)i, 0x5EEDu) % (uint32)(i + 1));
+        Swap(P[i], P[j]);
+    }
+
+    for (int32 i = 0; i < 256; i++)
+    {
+        Permutation[i] = P[i];
+        Permutation[256 + i] = P[i];
+    }
+}
+
+void FFixedPointNoise::GenerateField(int32 Width, int32 Height, int32 ScaleQ16, int32 OffsetXQ16, int32 OffsetYQ16,
+    int32 NumOctaves, int32 PersistenceQ12, int32 LacunarityQ12, TArray<int32>& OutField) const
+{
+    OutField.SetNumUninitialized(Width * Height);
+
+    int64 CoordX[4];
+    int64 CoordY[4];
+    int32 Noise[4];
+
+    for (int32 Y = 0; Y < Height; Y++)
+    {
+        for (int32 X = 0; X < Width; X += 4)
+        {
+            // β 4 ʱظһ񣬶ĽֱӶ
+            for (int32 Lane = 0; Lane < 4; Lane++)
+            {
+                const int32 LaneX = FMath::Min(X + Lane, Width - 1);
+                CoordX[Lane] = (int64)LaneX * ScaleQ16 + OffsetXQ16;
+                CoordY[Lane] = (int64)Y * ScaleQ16 + OffsetYQ16;
+            }
+
+            OctaveNoise4(CoordX, CoordY, NumOctaves, PersistenceQ12, LacunarityQ12, Noise);
+
+            const int32 NumLanes = FMath::Min(4, Width - X);
+            for (int32 Lane = 0; Lane < NumLanes; Lane++)
+            {
+                OutField[Y * Width + X + Lane] = Noise[Lane];
+            }
+        }
+    }
+}
+
+void FFixedPointNoise::OctaveNoise4(const int64* CoordX, const int64* CoordY, int32 NumOctaves, int32 PersistenceQ12, int32 LacunarityQ12, int32* OutNoise) const
+{
+    VectorRegister4Int Total = VectorIntSet1(0);
+
+    int64 Frequency = One;
+    int32 Amplitude = One;
+    int64 MaxValue = 0;
+
+    int64 OctaveX[4];
+    int64 OctaveY[4];
+
+    for (int32 i = 0; i < NumOctaves; i++)
+    {
+        for (int32 Lane = 0; Lane < 4; Lane++)
+        {
+            OctaveX[Lane] = (CoordX[Lane] * Frequency) >> FracBits;
+            OctaveY[Lane] = (CoordY[Lane] * Frequency) >> FracBits;
+        }
+
+        AccumulatePerlin4(OctaveX, OctaveY, Amplitude, Total);
+
+        MaxValue += Amplitude;
+        Amplitude = (Amplitude * PersistenceQ12) >> FracBits;
+        Frequency = (Frequency * LacunarityQ12) >> FracBits;
+    }
+
+    alignas(16) int32 Totals[4];
+    VectorIntStoreAligned(Total, Totals);
+
+    for (int32 Lane = 0; Lane < 4; Lane++)
+    {
+        OutNoise[Lane] = MaxValue > 0 ? (int32)((int64)Totals[Lane] * One / MaxValue) : 0;
+    }
+}
+
+void FFixedPointNoise::AccumulatePerlin4(const int64* CoordX, const int64* CoordY, int32 Amplitude, VectorRegister4Int& Total) const
+{
+    alignas(16) int32 Xf[4], Yf[4];
+    alignas(16) int32 GxAA[4], GyAA[4], GxBA[4], GyBA[4], GxAB[4], GyAB[4], GxBB[4], GyBB[4];
+
+    // · (SSE û gather)
+    for (int32 Lane = 0; Lane < 4; Lane++)
+    {
+        const int32 Xi = (int32)(CoordX[Lane] >> CoordFracBits) & 255;
+        const int32 Yi = (int32)(CoordY[Lane] >> CoordFracBits) & 255;
+        Xf[Lane] = (int32)(CoordX[Lane] >> (CoordFracBits - FracBits)) & (One - 1);
+        Yf[Lane] = (int32)(CoordY[Lane] >> (CoordFracBits - FracBits)) & (One - 1);
+
+        const int32 AA = Permutation[Permutation[Xi] + Yi] & 3;
+        const int32 AB = Permutation[Permutation[Xi] + Yi + 1] & 3;
+        const int32 BA = Permutation[Permutation[Xi + 1] + Yi] & 3;
+        const int32 BB = Permutation[Permutation[Xi + 1] + Yi + 1] & 3;
+
+        GxAA[Lane] = GradX[AA]; GyAA[Lane] = GradY[AA];
+        GxAB[Lane] = GradX[AB]; GyAB[Lane] = GradY[AB];
+        GxBA[Lane] = GradX[BA]; GyBA[Lane] = GradY[BA];
+        GxBB[Lane] = GradX[BB]; GyBB[Lane] = GradY[BB];
+    }
+
+    // ݶȵͲֵ 4 ·
+    const VectorRegister4Int VOne = VectorIntSet1(One);
+    const VectorRegister4Int X0 = VectorIntLoadAligned(Xf);
+    const VectorRegister4Int Y0 = VectorIntLoadAligned(Yf);
+    const VectorRegister4Int X1 = VectorIntSubtract(X0, VOne);
+    const VectorRegister4Int Y1 = VectorIntSubtract(Y0, VOne);
+
+    const VectorRegister4Int U = FixedFade4(X0);
+    const VectorRegister4Int V = FixedFade4(Y0);
+
+    const VectorRegister4Int Lerp1 = FixedLerp4(FixedGrad4(GxAA, GyAA, X0, Y0), FixedGrad4(GxBA, GyBA, X1, Y0), U);
+    const VectorRegister4Int Lerp2 = FixedLerp4(FixedGrad4(GxAB, GyAB, X0, Y1), FixedGrad4(GxBB, GyBB, X1, Y1), U);
+
+    // 븡ͬһ [0, 1] 
+    VectorRegister4Int Noise = VectorShiftRightImmArithmetic(VectorIntAdd(FixedLerp4(Lerp1, Lerp2, V), VOne), 1);
+    Noise = VectorShiftRightImmArithmetic(VectorIntMultiply(Noise, VectorIntSet1(Amplitude)), FracBits);
+
+    Total = VectorIntAdd(Total, Noise);
+}
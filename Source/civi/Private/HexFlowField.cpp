@@ -0,0 +1,145 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexFlowField.h"
+#include "HexMath.h"
+
+namespace
+{
+    struct FFlowNode
+    {
+        int32 Dist;
+        int32 Index;
+    };
+
+    struct FFlowNodeLess
+    {
+        FORCEINLINE bool operator()(const FFlowNode& A, const FFlowNode& B) const
+        {
+            return A.Dist < B.Dist || (A.Dist == B.Dist && A.Index < B.Index);
+        }
+    };
+
+    void SortTargets(TConstArrayView<int32> TargetIndices, TArray<int32>& OutTargets)
+    {
+        OutTargets.Reset(TargetIndices.Num());
+        OutTargets.Append(TargetIndices.GetData(), TargetIndices.Num());
+        OutTargets.Sort();
+        for (int32 i = OutTargets.Num() - 1; i > 0; i--)
+        {
+            if (OutTargets[i] == OutTargets[i - 1]) OutTargets.RemoveAt(i, 1, EAllowShrinking::No);
+        }
+    }
+
+    uint32 HashTargets(const TArray<int32>& SortedTargets, int32 MaxMovementPoints, EMovementClass MovementClass)
+    {
+        uint32 Hash = HashCombineFast(::GetTypeHash(MaxMovementPoints), ::GetTypeHash((uint8)MovementClass));
+        for (int32 Target : SortedTargets)
+        {
+            Hash = HashCombineFast(Hash, ::GetTypeHash(Target));
+        }
+        return Hash;
+    }
+}
+
+void FHexFlowField::Build(const FMovementCostGrid& Grid, TConstArrayView<int32> TargetIndices, int32 InMaxMovementPoints, EMovementClass InMovementClass)
+{
+    Width = Grid.Width;
+    Height = Grid.Height;
+    MaxMovementPoints = FMath::Max(1, InMaxMovementPoints);
+    MovementClass = InMovementClass;
+    SortTargets(TargetIndices, Targets);
+
+    const int32 NumTiles = Grid.Num();
+    const int32 NumWords = (NumTiles + TilesPerWord - 1) / TilesPerWord;
+
+    // ȫʼΪ޷ (ÿֵ 63 λȫΪ 1)
+    Packed.Init(0x7FFFFFFFFFFFFFFFull, NumWords);
+    if (!Grid.IsValid()) return;
+
+    TArray<int32> Dist;
+    Dist.Init(MAX_int32, NumTiles);
+
+    TArray<FFlowNode> Heap;
+    for (int32 Target : Targets)
+    {
+        if (!Grid.Costs.IsValidIndex(Target)) continue;
+
+        Dist[Target] = 0;
+        SetDirection(Target, DirTarget);
+        Heap.HeapPush({ 0, Target }, FFlowNodeLess());
+    }
+
+    // չ Current ھ Prev ߽ Current  (Ǵ/½)
+    FFlowNode Current;
+    while (Heap.Num() > 0)
+    {
+        Heap.HeapPop(Current, FFlowNodeLess(), EAllowShrinking::No);
+        if (Current.Dist != Dist[Current.Index]) continue;
+
+        const int32 X = Current.Index % Width;
+        const int32 Y = Current.Index / Width;
+
+        for (int32 Dir = 0; Dir < 6; Dir++)
+        {
+            const int32 Prev = FHexMath::GetNeighborIndex(X, Y, Dir, Width, Height);
+            if (Prev == INDEX_NONE || Grid.GetCost(MovementClass, Prev) == 0) continue;
+
+            const int32 StepCost = FHexPathfinder::ClampStepCost(Grid.GetStepCost(MovementClass, Prev, Current.Index), MaxMovementPoints);
+            const int32 NewDist = Current.Dist + StepCost;
+            if (NewDist >= Dist[Prev]) continue;
+
+            // ෴Prev  Current ǰ
+            Dist[Prev] = NewDist;
+            SetDirection(Prev, (uint8)((Dir + 3) % 6));
+            Heap.HeapPush({ NewDist, Prev }, FFlowNodeLess());
+        }
+    }
+}
+
+int32 FHexFlowField::GetNextIndex(int32 TileIndex) const
+{
+    if (TileIndex < 0 || TileIndex >= Width * Height) return INDEX_NONE;
+
+    const uint8 Dir = GetDirection(TileIndex);
+    if (Dir >= DirTarget) return INDEX_NONE;
+
+    return FHexMath::GetNeighborIndex(TileIndex % Width, TileIndex / Width, Dir, Width, Height);
+}
+
+TSharedRef<const FHexFlowField> FHexFlowFieldCache::FindOrBuild(const FMovementCostGrid& Grid, TConstArrayView<int32> TargetIndices, int32 MaxMovementPoints, EMovementClass MovementClass, int32 CurrentTurn)
+{
+    TArray<int32> SortedTargets;
+    SortTargets(TargetIndices, SortedTargets);
+    MaxMovementPoints = FMath::Max(1, MaxMovementPoints);
+
+    const uint32 Hash = HashTargets(SortedTargets, MaxMovementPoints, MovementClass);
+
+    TArray<FEntry*, TInlineAllocator<4>> Candidates;
+    Entries.MultiFindPointer(Hash, Candidates);
+    for (FEntry* Entry : Candidates)
+    {
+        if (Entry->Field->GetMaxMovementPoints() == MaxMovementPoints && Entry->Field->GetMovementClass() == MovementClass
+            && Entry->Field->GetTargets() == SortedTargets)
+        {
+            Entry->LastUsedTurn = CurrentTurn;
+            return Entry->Field;
+        }
+    }
+
+    TSharedRef<FHexFlowField> Field = MakeShared<FHexFlowField>();
+    Field->Build(Grid, SortedTargets, MaxMovementPoints, MovementClass);
+
+    Entries.Add(Hash, { Field, CurrentTurn });
+    return Field;
+}
+
+void FHexFlowFieldCache::AgeOut(int32 CurrentTurn)
+{
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        if (CurrentTurn - It.Value().LastUsedTurn > MaxIdleTurns)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
@@ -0,0 +1,633 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexHierarchicalPathfinder.h"
+#include "HexMath.h"
+#include "HAL/ThreadSingleton.h"
+#include "Math/RandomStream.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Reverse.h"
+
+namespace
+{
+    struct FAbstractOpenNode
+    {
+        int32 F;
+        int32 G;
+        int32 Id;
+    };
+
+    struct FAbstractOpenNodeLess
+    {
+        FORCEINLINE bool operator()(const FAbstractOpenNode& A, const FAbstractOpenNode& B) const
+        {
+            return A.F < B.F || (A.F == B.F && A.G > B.G);
+        }
+    };
+
+    // ͼȫֽڵŷ
+    struct FAbstractSearchBuffers : public TThreadSingleton<FAbstractSearchBuffers>
+    {
+        TArray<uint32> VisitStamp;
+        TArray<int32> BestCost;
+        TArray<int32> Parent;
+        TArray<FAbstractOpenNode> OpenHeap;
+        uint32 Generation = 0;
+
+        void Prepare(int32 NumNodes)
+        {
+            if (VisitStamp.Num() < NumNodes)
+            {
+                VisitStamp.Init(0, NumNodes);
+                BestCost.SetNumUninitialized(NumNodes);
+                Parent.SetNumUninitialized(NumNodes);
+                Generation = 0;
+            }
+
+            if (++Generation == 0)
+            {
+                FMemory::Memzero(VisitStamp.GetData(), VisitStamp.Num() * sizeof(uint32));
+                Generation = 1;
+            }
+
+            OpenHeap.Reset();
+        }
+    };
+}
+
+int32 FHexHierarchicalPathfinder::GetClusterOfTile(int32 TileIndex) const
+{
+    const int32 X = TileIndex % Width;
+    const int32 Y = TileIndex / Width;
+    return (Y / ClusterSize) * ClustersX + (X / ClusterSize);
+}
+
+void FHexHierarchicalPathfinder::GetNeighborClusters(int32 ClusterId, TArray<int32, TInlineAllocator<8>>& OutNeighbors) const
+{
+    OutNeighbors.Reset();
+
+    const int32 CX = ClusterId % ClustersX;
+    const int32 CY = ClusterId / ClustersX;
+
+    // еƫƻôصĽбĴ
+    for (int32 DY = -1; DY <= 1; DY++)
+    {
+        const int32 NCY = CY + DY;
+        if (NCY < 0 || NCY >= ClustersY) continue;
+
+        for (int32 DX = -1; DX <= 1; DX++)
+        {
+            const int32 Neighbor = NCY * ClustersX + FHexMath::WrapX(CX + DX, ClustersX);
+            if (Neighbor != ClusterId)
+            {
+                OutNeighbors.AddUnique(Neighbor);
+            }
+        }
+    }
+}
+
+uint64 FHexHierarchicalPathfinder::MakePairKey(int32 ClusterA, int32 ClusterB)
+{
+    const uint32 Lo = (uint32)FMath::Min(ClusterA, ClusterB);
+    const uint32 Hi = (uint32)FMath::Max(ClusterA, ClusterB);
+    return ((uint64)Lo << 32) | Hi;
+}
+
+void FHexHierarchicalPathfinder::Build(const FMovementCostGrid& Grid)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    Width = Grid.Width;
+    Height = Grid.Height;
+    ClustersX = FMath::DivideAndRoundUp(Width, ClusterSize);
+    ClustersY = FMath::DivideAndRoundUp(Height, ClusterSize);
+
+    Clusters.Reset();
+    Clusters.SetNum(ClustersX * ClustersY);
+    Entrances.Reset();
+    DirtyClusters.Reset();
+
+    for (int32 ClusterId = 0; ClusterId < Clusters.Num(); ClusterId++)
+    {
+        FCluster& Cluster = Clusters[ClusterId];
+        Cluster.MinX = (ClusterId % ClustersX) * ClusterSize;
+        Cluster.MinY = (ClusterId / ClustersX) * ClusterSize;
+        Cluster.SizeX = FMath::Min(ClusterSize, Width - Cluster.MinX);
+        Cluster.SizeY = FMath::Min(ClusterSize, Height - Cluster.MinY);
+    }
+
+    // 1. ÿڴֻһ
+    TArray<int32, TInlineAllocator<8>> Neighbors;
+    for (int32 ClusterId = 0; ClusterId < Clusters.Num(); ClusterId++)
+    {
+        GetNeighborClusters(ClusterId, Neighbors);
+        for (int32 Neighbor : Neighbors)
+        {
+            if (Neighbor > ClusterId)
+            {
+                BuildEntrances(Grid, ClusterId, Neighbor);
+            }
+        }
+    }
+
+    // 2. ռڵ㲢
+    for (int32 ClusterId = 0; ClusterId < Clusters.Num(); ClusterId++)
+    {
+        BuildClusterNodes(Grid, ClusterId);
+    }
+
+    UpdateNodeOffsets();
+
+    UE_LOG(LogTemp, Log, TEXT("HPA* build: %d clusters, %d entrance nodes in %.2f ms"),
+        Clusters.Num(), TotalNodes, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FHexHierarchicalPathfinder::MarkTileDirty(int32 TileIndex)
+{
+    if (Clusters.Num() == 0 || TileIndex < 0 || TileIndex >= Width * Height) return;
+
+    DirtyClusters.Add(GetClusterOfTile(TileIndex));
+}
+
+void FHexHierarchicalPathfinder::RebuildDirtyClusters(const FMovementCostGrid& Grid)
+{
+    if (DirtyClusters.Num() == 0) return;
+
+    // ر߽ڶ仯ڴصĽڵҲҪռ
+    TSet<int32> AffectedClusters;
+    TArray<int32, TInlineAllocator<8>> Neighbors;
+
+    for (int32 ClusterId : DirtyClusters)
+    {
+        AffectedClusters.Add(ClusterId);
+
+        GetNeighborClusters(ClusterId, Neighbors);
+        for (int32 Neighbor : Neighbors)
+        {
+            BuildEntrances(Grid, ClusterId, Neighbor);
+            AffectedClusters.Add(Neighbor);
+        }
+    }
+
+    for (int32 ClusterId : AffectedClusters)
+    {
+        BuildClusterNodes(Grid, ClusterId);
+    }
+
+    UpdateNodeOffsets();
+    DirtyClusters.Reset();
+}
+
+void FHexHierarchicalPathfinder::BuildEntrances(const FMovementCostGrid& Grid, int32 ClusterA, int32 ClusterB)
+{
+    const int32 Lo = FMath::Min(ClusterA, ClusterB);
+    const int32 Hi = FMath::Max(ClusterA, ClusterB);
+    const FCluster& Cluster = Clusters[Lo];
+
+    TArray<FEntrance>& List = Entrances.FindOrAdd(MakePairKey(Lo, Hi));
+    List.Reset();
+
+    // ر߽˳ռĿͨеؿԣÿֻһ
+    TArray<FEntrance, TInlineAllocator<ClusterSize * 2>> Run;
+
+    auto FlushRun = [&List, &Run]()
+    {
+        if (Run.Num() == 0) return;
+
+        if (Run.Num() < MaxEntranceWidth)
+        {
+            List.Add(Run[Run.Num() / 2]);
+        }
+        else
+        {
+            List.Add(Run[0]);
+            List.Add(Run.Last());
+        }
+        Run.Reset();
+    };
+
+    for (int32 LY = 0; LY < Cluster.SizeY; LY++)
+    {
+        for (int32 LX = 0; LX < Cluster.SizeX; LX++)
+        {
+            const int32 X = Cluster.MinX + LX;
+            const int32 Y = Cluster.MinY + LY;
+            const int32 TileA = Y * Width + X;
+            if (Grid.Costs[TileA] == 0) continue;
+
+            int32 TileB = INDEX_NONE;
+            for (int32 Dir = 0; Dir < 6 && TileB == INDEX_NONE; Dir++)
+            {
+                const int32 Neighbor = FHexMath::GetNeighborIndex(X, Y, Dir, Width, Height);
+                if (Neighbor != INDEX_NONE && Grid.Costs[Neighbor] != 0 && GetClusterOfTile(Neighbor) == Hi)
+                {
+                    TileB = Neighbor;
+                }
+            }
+            if (TileB == INDEX_NONE) continue;
+
+            // һڵؿ鲻ʱʼµһ
+            if (Run.Num() > 0)
+            {
+                const int32 PrevA = Run.Last().TileA;
+                if (FHexMath::Distance(PrevA % Width, PrevA / Width, X, Y, Width) > 1)
+                {
+                    FlushRun();
+                }
+            }
+            Run.Add({ TileA, TileB });
+        }
+    }
+    FlushRun();
+
+    if (List.Num() == 0)
+    {
+        Entrances.Remove(MakePairKey(Lo, Hi));
+    }
+}
+
+void FHexHierarchicalPathfinder::BuildClusterNodes(const FMovementCostGrid& Grid, int32 ClusterId)
+{
+    FCluster& Cluster = Clusters[ClusterId];
+
+    struct FPendingEdge
+    {
+        int32 OwnTile;
+        FInterEdge Edge;
+    };
+    TArray<FPendingEdge> PendingEdges;
+
+    TArray<int32, TInlineAllocator<8>> Neighbors;
+    GetNeighborClusters(ClusterId, Neighbors);
+    for (int32 Neighbor : Neighbors)
+    {
+        const TArray<FEntrance>* List = Entrances.Find(MakePairKey(ClusterId, Neighbor));
+        if (!List) continue;
+
+        const bool bIsLo = ClusterId < Neighbor;
+        for (const FEntrance& Entrance : *List)
+        {
+            const int32 OwnTile = bIsLo ? Entrance.TileA : Entrance.TileB;
+            const int32 OtherTile = bIsLo ? Entrance.TileB : Entrance.TileA;
+            PendingEdges.Add({ OwnTile, { Neighbor, OtherTile, (int32)Grid.Costs[OtherTile] } });
+        }
+    }
+
+    // 1. ڵȥ
+    Cluster.NodeTiles.Reset();
+    for (const FPendingEdge& Pending : PendingEdges)
+    {
+        Cluster.NodeTiles.Add(Pending.OwnTile);
+    }
+    Cluster.NodeTiles.Sort();
+    for (int32 i = Cluster.NodeTiles.Num() - 1; i > 0; i--)
+    {
+        if (Cluster.NodeTiles[i] == Cluster.NodeTiles[i - 1])
+        {
+            Cluster.NodeTiles.RemoveAt(i, 1, EAllowShrinking::No);
+        }
+    }
+
+    const int32 NumNodes = Cluster.NodeTiles.Num();
+
+    // 2. ر
+    Cluster.InterEdges.Reset();
+    Cluster.InterEdges.SetNum(NumNodes);
+    for (const FPendingEdge& Pending : PendingEdges)
+    {
+        const int32 Slot = Algo::BinarySearch(Cluster.NodeTiles, Pending.OwnTile);
+        Cluster.InterEdges[Slot].Add(Pending.Edge);
+    }
+
+    // 3. ڽڵ֮
+    Cluster.IntraCosts.SetNumUninitialized(NumNodes * NumNodes);
+
+    TArray<int32> Dist;
+    for (int32 From = 0; From < NumNodes; From++)
+    {
+        ClusterDijkstra(Grid, Cluster, Cluster.NodeTiles[From], false, Dist);
+
+        for (int32 To = 0; To < NumNodes; To++)
+        {
+            const int32 Tile = Cluster.NodeTiles[To];
+            const int32 Local = (Tile % Width - Cluster.MinX) + (Tile / Width - Cluster.MinY) * Cluster.SizeX;
+            Cluster.IntraCosts[From * NumNodes + To] = Dist[Local];
+        }
+    }
+}
+
+void FHexHierarchicalPathfinder::UpdateNodeOffsets()
+{
+    TotalNodes = 0;
+    for (FCluster& Cluster : Clusters)
+    {
+        Cluster.NodeOffset = TotalNodes;
+        TotalNodes += Cluster.NodeTiles.Num();
+    }
+}
+
+void FHexHierarchicalPathfinder::ClusterDijkstra(const FMovementCostGrid& Grid, const FCluster& Cluster, int32 SourceTile, bool bReverse, TArray<int32>& OutDist) const
+{
+    const int32 NumLocal = Cluster.SizeX * Cluster.SizeY;
+    OutDist.Init(MAX_int32, NumLocal);
+
+    auto ToLocal = [this, &Cluster](int32 Tile)
+    {
+        return (Tile % Width - Cluster.MinX) + (Tile / Width - Cluster.MinY) * Cluster.SizeX;
+    };
+
+    // (, ֲ) 
+    TArray<FIntPoint, TInlineAllocator<ClusterSize * ClusterSize>> Heap;
+    auto HeapLess = [](const FIntPoint& A, const FIntPoint& B) { return A.X < B.X; };
+
+    OutDist[ToLocal(SourceTile)] = 0;
+    Heap.HeapPush(FIntPoint(0, ToLocal(SourceTile)), HeapLess);
+
+    FIntPoint Top;
+    while (Heap.Num() > 0)
+    {
+        Heap.HeapPop(Top, HeapLess, EAllowShrinking::No);
+        if (Top.X != OutDist[Top.Y]) continue;
+
+        const int32 X = Cluster.MinX + Top.Y % Cluster.SizeX;
+        const int32 Y = Cluster.MinY + Top.Y / Cluster.SizeX;
+        const int32 Current = Y * Width + X;
+
+        for (int32 Dir = 0; Dir < 6; Dir++)
+        {
+            const int32 Next = FHexMath::GetNeighborIndex(X, Y, Dir, Width, Height);
+            if (Next == INDEX_NONE || Grid.Costs[Next] == 0) continue;
+
+            const int32 NX = Next % Width;
+            const int32 NY = Next / Width;
+            if (NX < Cluster.MinX || NX >= Cluster.MinX + Cluster.SizeX || NY < Cluster.MinY || NY >= Cluster.MinY + Cluster.SizeY) continue;
+
+            // ۼӽһģʱߵķ෴ۼӽ뵱ǰ
+            const int32 StepCost = bReverse ? Grid.Costs[Current] : Grid.Costs[Next];
+            const int32 NewDist = Top.X + StepCost;
+            const int32 NextLocal = ToLocal(Next);
+            if (NewDist < OutDist[NextLocal])
+            {
+                OutDist[NextLocal] = NewDist;
+                Heap.HeapPush(FIntPoint(NewDist, NextLocal), HeapLess);
+            }
+        }
+    }
+}
+
+bool FHexHierarchicalPathfinder::FindPath(const FMovementCostGrid& Grid, int32 StartIndex, int32 GoalIndex, int32 MaxMovementPoints, FHexHierarchicalPath& OutPath)
+{
+    OutPath.bFound = false;
+    OutPath.AbstractCost = 0;
+    OutPath.NodesExpanded = 0;
+    OutPath.Waypoints.Reset();
+    OutPath.RefinedPath.Reset();
+
+    if (!Grid.IsValid() || Grid.Width != Width || Grid.Height != Height) return false;
+    if (!Grid.Costs.IsValidIndex(StartIndex) || !Grid.Costs.IsValidIndex(GoalIndex)) return false;
+    if (StartIndex == GoalIndex || Grid.Costs[GoalIndex] == 0) return false;
+
+    // ͬһ½ϣ
+    if (!Grid.AreConnected(EMovementClass::Land, StartIndex, GoalIndex)) return false;
+
+    RebuildDirtyClusters(Grid);
+
+    const int32 MaxMP = FMath::Max(1, MaxMovementPoints);
+    const int32 GoalX = GoalIndex % Width;
+    const int32 GoalY = GoalIndex / Width;
+
+    FHexPathQuery Query;
+    Query.StartIndex = StartIndex;
+    Query.MaxMovementPoints = MaxMP;
+    Query.StartMovementPoints = MaxMP;
+
+    // 1. ֱʹ A*
+    if (FHexMath::Distance(StartIndex % Width, StartIndex / Width, GoalX, GoalY, Width) <= ClusterSize * 2)
+    {
+        Query.GoalIndex = GoalIndex;
+        const FHexPathResult Result = FHexPathfinder::FindPath(Grid, Query, OutPath.RefinedPath);
+
+        OutPath.bFound = Result.bFound;
+        OutPath.AbstractCost = Result.ArrivalTime;
+        OutPath.NodesExpanded = Result.NodesExpanded;
+        if (Result.bFound)
+        {
+            OutPath.Waypoints.Add(GoalIndex);
+        }
+        return Result.bFound;
+    }
+
+    // 2. յʱڴصڽڵ
+    const int32 StartCluster = GetClusterOfTile(StartIndex);
+    const int32 GoalCluster = GetClusterOfTile(GoalIndex);
+    const FCluster& StartClusterData = Clusters[StartCluster];
+    const FCluster& GoalClusterData = Clusters[GoalCluster];
+
+    TArray<int32> StartDist;
+    TArray<int32> GoalDist;
+    ClusterDijkstra(Grid, StartClusterData, StartIndex, false, StartDist);
+    ClusterDijkstra(Grid, GoalClusterData, GoalIndex, true, GoalDist);
+
+    auto ToLocal = [this](const FCluster& Cluster, int32 Tile)
+    {
+        return (Tile % Width - Cluster.MinX) + (Tile / Width - Cluster.MinY) * Cluster.SizeX;
+    };
+
+    // 3. ͼ A* (ڵţؽڵУյ)
+    const int32 StartId = TotalNodes;
+    const int32 GoalId = TotalNodes + 1;
+
+    // ڵ -> أôصʼŶֲ
+    auto ClusterOfNode = [this](int32 Id)
+    {
+        int32 Lo = 0;
+        int32 Hi = Clusters.Num() - 1;
+        while (Lo < Hi)
+        {
+            const int32 Mid = (Lo + Hi + 1) / 2;
+            if (Clusters[Mid].NodeOffset <= Id) Lo = Mid; else Hi = Mid - 1;
+        }
+        return Lo;
+    };
+
+    auto TileOfNode = [&](int32 Id)
+    {
+        if (Id == StartId) return StartIndex;
+        if (Id == GoalId) return GoalIndex;
+        const FCluster& Cluster = Clusters[ClusterOfNode(Id)];
+        return Cluster.NodeTiles[Id - Cluster.NodeOffset];
+    };
+
+    FAbstractSearchBuffers& Buffers = FAbstractSearchBuffers::Get();
+    Buffers.Prepare(TotalNodes + 2);
+
+    const uint32 Generation = Buffers.Generation;
+    uint32* VisitStamp = Buffers.VisitStamp.GetData();
+    int32* BestCost = Buffers.BestCost.GetData();
+    int32* Parent = Buffers.Parent.GetData();
+    TArray<FAbstractOpenNode>& OpenHeap = Buffers.OpenHeap;
+
+    auto Relax = [&](int32 Id, int32 Tile, int32 NewCost, int32 From)
+    {
+        if (VisitStamp[Id] == Generation && NewCost >= BestCost[Id]) return;
+
+        VisitStamp[Id] = Generation;
+        BestCost[Id] = NewCost;
+        Parent[Id] = From;
+
+        const int32 H = FHexMath::Distance(Tile % Width, Tile / Width, GoalX, GoalY, Width);
+        OpenHeap.HeapPush({ NewCost + H, NewCost, Id }, FAbstractOpenNodeLess());
+    };
+
+    Relax(StartId, StartIndex, 0, INDEX_NONE);
+
+    FAbstractOpenNode Current;
+    bool bReachedGoal = false;
+    while (OpenHeap.Num() > 0)
+    {
+        OpenHeap.HeapPop(Current, FAbstractOpenNodeLess(), EAllowShrinking::No);
+        if (Current.G != BestCost[Current.Id]) continue;
+
+        OutPath.NodesExpanded++;
+
+        if (Current.Id == GoalId)
+        {
+            bReachedGoal = true;
+            break;
+        }
+
+        if (Current.Id == StartId)
+        {
+            for (int32 Slot = 0; Slot < StartClusterData.NodeTiles.Num(); Slot++)
+            {
+                const int32 Tile = StartClusterData.NodeTiles[Slot];
+                const int32 Dist = StartDist[ToLocal(StartClusterData, Tile)];
+                if (Dist != MAX_int32)
+                {
+                    Relax(StartClusterData.NodeOffset + Slot, Tile, Dist, StartId);
+                }
+            }
+            continue;
+        }
+
+        const int32 ClusterId = ClusterOfNode(Current.Id);
+        const FCluster& Cluster = Clusters[ClusterId];
+        const int32 Slot = Current.Id - Cluster.NodeOffset;
+        const int32 NumNodes = Cluster.NodeTiles.Num();
+
+        // ڱ
+        for (int32 To = 0; To < NumNodes; To++)
+        {
+            const int32 Cost = Cluster.IntraCosts[Slot * NumNodes + To];
+            if (To != Slot && Cost != MAX_int32)
+            {
+                Relax(Cluster.NodeOffset + To, Cluster.NodeTiles[To], Current.G + Cost, Current.Id);
+            }
+        }
+
+        // ر
+        for (const FInterEdge& Edge : Cluster.InterEdges[Slot])
+        {
+            const FCluster& Target = Clusters[Edge.TargetCluster];
+            const int32 TargetSlot = Algo::BinarySearch(Target.NodeTiles, Edge.TargetTile);
+            if (TargetSlot != INDEX_NONE)
+            {
+                Relax(Target.NodeOffset + TargetSlot, Edge.TargetTile, Current.G + Edge.Cost, Current.Id);
+            }
+        }
+
+        // յڴصĽڵֱյ
+        if (ClusterId == GoalCluster)
+        {
+            const int32 Dist = GoalDist[ToLocal(Cluster, Cluster.NodeTiles[Slot])];
+            if (Dist != MAX_int32)
+            {
+                Relax(GoalId, GoalIndex, Current.G + Dist, Current.Id);
+            }
+        }
+    }
+
+    if (!bReachedGoal) return false;
+
+    OutPath.AbstractCost = BestCost[GoalId];
+    for (int32 Id = GoalId; Id != StartId; Id = Parent[Id])
+    {
+        OutPath.Waypoints.Add(TileOfNode(Id));
+    }
+    Algo::Reverse(OutPath.Waypoints);
+
+    // 4. ֻϸһ뿪ص·
+    int32 FirstTarget = GoalIndex;
+    for (int32 Waypoint : OutPath.Waypoints)
+    {
+        if (GetClusterOfTile(Waypoint) != StartCluster)
+        {
+            FirstTarget = Waypoint;
+            break;
+        }
+    }
+
+    Query.GoalIndex = FirstTarget;
+    OutPath.bFound = FHexPathfinder::FindPath(Grid, Query, OutPath.RefinedPath).bFound;
+    return OutPath.bFound;
+}
+
+void FHexHierarchicalPathfinder::RunBenchmark(int32 Width, int32 Height, int32 NumQueries, int32 Seed)
+{
+    if (Width <= 0 || Height <= 0 || NumQueries <= 0) return;
+
+    FMovementCostGrid Grid;
+    FHexPathfinder::MakeRandomGrid(Width, Height, Seed, Grid);
+
+    FHexHierarchicalPathfinder Hierarchy;
+    Hierarchy.Build(Grid);
+
+    // Զѯյ϶̱߳ķ֮һ
+    FRandomStream Random(Seed);
+    const int32 MinDistance = FMath::Min(Width, Height) / 4;
+
+    TArray<FIntPoint> Pairs;
+    for (int32 Attempt = 0; Attempt < NumQueries * 64 && Pairs.Num() < NumQueries; Attempt++)
+    {
+        const int32 Start = Random.RandRange(0, Grid.Num() - 1);
+        const int32 Goal = Random.RandRange(0, Grid.Num() - 1);
+        if (Grid.Costs[Start] == 0 || Grid.Costs[Goal] == 0) continue;
+        if (FHexMath::Distance(Start % Width, Start / Width, Goal % Width, Goal / Width, Width) < MinDistance) continue;
+
+        Pairs.Add(FIntPoint(Start, Goal));
+    }
+    if (Pairs.Num() == 0) return;
+
+    TArray<int32> FlatPath;
+    int32 FlatFound = 0;
+    int64 FlatNodes = 0;
+
+    double StartTime = FPlatformTime::Seconds();
+    for (const FIntPoint& Pair : Pairs)
+    {
+        FHexPathQuery Query;
+        Query.StartIndex = Pair.X;
+        Query.GoalIndex = Pair.Y;
+        const FHexPathResult Result = FHexPathfinder::FindPath(Grid, Query, FlatPath);
+        FlatFound += Result.bFound ? 1 : 0;
+        FlatNodes += Result.NodesExpanded;
+    }
+    const double FlatMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    FHexHierarchicalPath Path;
+    int32 HierarchicalFound = 0;
+    int64 HierarchicalNodes = 0;
+
+    StartTime = FPlatformTime::Seconds();
+    for (const FIntPoint& Pair : Pairs)
+    {
+        HierarchicalFound += Hierarchy.FindPath(Grid, Pair.X, Pair.Y, 2, Path) ? 1 : 0;
+        HierarchicalNodes += Path.NodesExpanded;
+    }
+    const double HierarchicalMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    UE_LOG(LogTemp, Log, TEXT("HPA* benchmark %dx%d, %d long queries: A* %.3f ms/query (found %d, avg nodes %.0f), HPA* %.3f ms/query (found %d, avg abstract nodes %.0f), speedup x%.1f"),
+        Width, Height, Pairs.Num(),
+        FlatMs / Pairs.Num(), FlatFound, (double)FlatNodes / Pairs.Num(),
+        HierarchicalMs / Pairs.Num(), HierarchicalFound, (double)HierarchicalNodes / Pairs.Num(),
+        HierarchicalMs > 0.0 ? FlatMs / HierarchicalMs : 0.0);
+}
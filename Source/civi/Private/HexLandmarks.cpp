@@ -0,0 +1,217 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexLandmarks.h"
+#include "HexMath.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+    struct FLandmarkNode
+    {
+        int32 Dist;
+        int32 Index;
+    };
+
+    struct FLandmarkNodeLess
+    {
+        FORCEINLINE bool operator()(const FLandmarkNode& A, const FLandmarkNode& B) const
+        {
+            return A.Dist < B.Dist;
+        }
+    };
+}
+
+void FHexLandmarkTable::Dijkstra(const FMovementCostGrid& Grid, EMovementClass Class, int32 Source, TArray<uint16>& OutDist)
+{
+    const int32 Width = Grid.Width;
+    const int32 Height = Grid.Height;
+
+    TArray<int32> Dist;
+    Dist.Init(MAX_int32, Grid.Num());
+
+    TArray<FLandmarkNode> Heap;
+    Dist[Source] = 0;
+    Heap.HeapPush({ 0, Source }, FLandmarkNodeLess());
+
+    FLandmarkNode Current;
+    while (Heap.Num() > 0)
+    {
+        Heap.HeapPop(Current, FLandmarkNodeLess(), EAllowShrinking::No);
+        if (Current.Dist != Dist[Current.Index]) continue;
+
+        const int32 X = Current.Index % Width;
+        const int32 Y = Current.Index / Width;
+        for (int32 Dir = 0; Dir < 6; Dir++)
+        {
+            const int32 Next = FHexMath::GetNeighborIndex(X, Y, Dir, Width, Height);
+            if (Next == INDEX_NONE || Grid.GetCost(Class, Next) == 0) continue;
+
+            const int32 NewDist = Current.Dist + FHexPathfinder::ClampStepCost(Grid.GetStepCost(Class, Current.Index, Next), StepClamp);
+            if (NewDist >= Dist[Next]) continue;
+
+            Dist[Next] = NewDist;
+            Heap.HeapPush({ NewDist, Next }, FLandmarkNodeLess());
+        }
+    }
+
+    OutDist.SetNumUninitialized(Grid.Num());
+    for (int32 Index = 0; Index < Grid.Num(); Index++)
+    {
+        //  uint16 ľΪ (½ȻЧֻǷõر)
+        OutDist[Index] = Dist[Index] < (int32)Unreachable ? (uint16)Dist[Index] : Unreachable;
+    }
+}
+
+void FHexLandmarkTable::Build(const FMovementCostGrid& Grid)
+{
+    Width = Grid.Width;
+    Height = Grid.Height;
+
+    for (int32 ClassIndex = 0; ClassIndex < FMovementCostGrid::NumMovementClasses; ClassIndex++)
+    {
+        const EMovementClass Class = (EMovementClass)ClassIndex;
+        FClassLandmarks& Data = Classes[ClassIndex];
+        Data.Landmarks.Reset();
+        Data.Distances.Reset();
+
+        const TArray<int32>& Labels = Grid.Components[ClassIndex];
+        if (Labels.Num() != Grid.Num()) continue;
+
+        // һرͨ
+        TMap<int32, int32> ComponentSizes;
+        for (int32 Label : Labels)
+        {
+            if (Label != INDEX_NONE) ComponentSizes.FindOrAdd(Label)++;
+        }
+        if (ComponentSizes.Num() == 0) continue;
+
+        int32 LargestLabel = INDEX_NONE;
+        int32 LargestSize = 0;
+        for (const TPair<int32, int32>& Pair : ComponentSizes)
+        {
+            if (Pair.Value > LargestSize || (Pair.Value == LargestSize && Pair.Key < LargestLabel))
+            {
+                LargestLabel = Pair.Key;
+                LargestSize = Pair.Value;
+            }
+        }
+
+        // ̫Сķֵýر
+        if (LargestSize < 64) continue;
+
+        const int32 First = Labels.IndexOfByKey(LargestLabel);
+
+        // ԶÿµرȡеرԶĵؿ
+        TArray<int32> MinDist;
+        MinDist.Init(MAX_int32, Grid.Num());
+
+        int32 Next = First;
+        while (Next != INDEX_NONE && Data.Landmarks.Num() < NumLandmarks)
+        {
+            Data.Landmarks.Add(Next);
+            TArray<uint16>& Dist = Data.Distances.AddDefaulted_GetRef();
+            Dijkstra(Grid, Class, Next, Dist);
+
+            Next = INDEX_NONE;
+            int32 Farthest = 0;
+            for (int32 Index = 0; Index < Grid.Num(); Index++)
+            {
+                if (Labels[Index] != LargestLabel || Dist[Index] == Unreachable) continue;
+
+                MinDist[Index] = FMath::Min(MinDist[Index], (int32)Dist[Index]);
+                if (MinDist[Index] > Farthest)
+                {
+                    Farthest = MinDist[Index];
+                    Next = Index;
+                }
+            }
+        }
+    }
+}
+
+SIZE_T FHexLandmarkTable::GetAllocatedSize() const
+{
+    SIZE_T Size = 0;
+    for (const FClassLandmarks& Data : Classes)
+    {
+        Size += Data.Landmarks.GetAllocatedSize() + Data.Distances.GetAllocatedSize();
+        for (const TArray<uint16>& Dist : Data.Distances)
+        {
+            Size += Dist.GetAllocatedSize();
+        }
+    }
+    return Size;
+}
+
+void FHexLandmarkTable::RunBenchmarkOnGrid(const FMovementCostGrid& Grid, int32 NumQueries, int32 Seed, const TCHAR* Label)
+{
+    if (!Grid.IsValid() || NumQueries <= 0) return;
+
+    // ʹһݴرĸӰ÷
+    FMovementCostGrid WithLandmarks = Grid;
+
+    const double BuildStart = FPlatformTime::Seconds();
+    TSharedRef<FHexLandmarkTable> Table = MakeShared<FHexLandmarkTable>();
+    Table->Build(WithLandmarks);
+    const double BuildMs = (FPlatformTime::Seconds() - BuildStart) * 1000.0;
+    WithLandmarks.Landmarks = Table;
+
+    FMovementCostGrid Plain = Grid;
+    Plain.Landmarks.Reset();
+
+    FRandomStream Random(Seed);
+
+    // ֻȡͬһͨڵԶѯ
+    TArray<FHexPathQuery> Queries;
+    for (int32 Attempt = 0; Attempt < NumQueries * 64 && Queries.Num() < NumQueries; Attempt++)
+    {
+        FHexPathQuery Query;
+        Query.StartIndex = Random.RandRange(0, Grid.Num() - 1);
+        Query.GoalIndex = Random.RandRange(0, Grid.Num() - 1);
+        if (!Grid.AreConnected(EMovementClass::Land, Query.StartIndex, Query.GoalIndex)) continue;
+
+        Query.MaxMovementPoints = 2;
+        Query.StartMovementPoints = 2;
+        Queries.Add(Query);
+    }
+    if (Queries.Num() == 0) return;
+
+    TArray<int32> Path;
+    Path.Reserve(Grid.Num());
+
+    auto RunAll = [&Queries, &Path](const FMovementCostGrid& Target, TArray<int32>& OutArrival, int64& OutNodes)
+    {
+        OutArrival.Reset();
+        OutNodes = 0;
+
+        // Ԥȱ̵߳
+        FHexPathfinder::FindPath(Target, Queries[0], Path);
+
+        const double StartTime = FPlatformTime::Seconds();
+        for (const FHexPathQuery& Query : Queries)
+        {
+            const FHexPathResult Result = FHexPathfinder::FindPath(Target, Query, Path);
+            OutArrival.Add(Result.bFound ? Result.ArrivalTime : -1);
+            OutNodes += Result.NodesExpanded;
+        }
+        return (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    };
+
+    TArray<int32> PlainArrival, LandmarkArrival;
+    int64 PlainNodes = 0, LandmarkNodes = 0;
+    const double PlainMs = RunAll(Plain, PlainArrival, PlainNodes);
+    const double LandmarkMs = RunAll(WithLandmarks, LandmarkArrival, LandmarkNodes);
+
+    int32 NumMismatch = 0;
+    for (int32 i = 0; i < Queries.Num(); i++)
+    {
+        if (PlainArrival[i] != LandmarkArrival[i]) NumMismatch++;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Landmark benchmark [%s] %dx%d: build %.1f ms, %.1f MB, %d queries"),
+        Label, Grid.Width, Grid.Height, BuildMs, Table->GetAllocatedSize() / (1024.0 * 1024.0), Queries.Num());
+    UE_LOG(LogTemp, Log, TEXT("  Hex distance: %.2f ms (%.1f us/query), avg nodes %.0f"),
+        PlainMs, PlainMs * 1000.0 / Queries.Num(), (double)PlainNodes / Queries.Num());
+    UE_LOG(LogTemp, Log, TEXT("  Landmarks:    %.2f ms (%.1f us/query), avg nodes %.0f, %d arrival mismatches"),
+        LandmarkMs, LandmarkMs * 1000.0 / Queries.Num(), (double)LandmarkNodes / Queries.Num(), NumMismatch);
+}
@@ -4,10 +4,38 @@
 #include "Landblock.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
 #include "Building.h"
 #include "BuildingDataAsset.h"
 #include "WonderDataAsset.h"
 #include "Wonder.h"
+#include "HexTileMemory.h"
+#include "FixedPointNoise.h"
+#include "Misc/Crc.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace
+{
+    // еҰ״̬
+    // 0 = Unexplored (ػɫ)
+    // 128 = FogOfWar (䰵)
+    // 255 = Visible ()
+    uint8 GetFogTexelValue(EVisibilityState State)
+    {
+        switch (State)
+        {
+            case EVisibilityState::FogOfWar: return 128;
+            case EVisibilityState::Visible:  return 255;
+            default:                         return 0;
+        }
+    }
+
+    // ʺ MF_HexFog ȡĲ
+    const FName FogTextureParam(TEXT("FogTexture"));
+    const FName FogLayoutParam(TEXT("FogLayout"));
+    const FName FogOriginParam(TEXT("FogOrigin"));
+}
 
 AHexMapRenderer::AHexMapRenderer()
 {
@@ -24,28 +52,21 @@ void AHexMapRenderer::BeginPlay()
 
 FVector AHexMapRenderer::CalculateHexWorldPosition(int32 X, int32 Y) const
 {
-    // ת
-    // ʹ "pointy-top" β֣㳯ϣ
-
-    float Width = HexRadius * 2.0f + HexGap;
-    float Height = HexRadius * FMath::Sqrt(3.0f) + HexGap;
-
-    float WorldX = X * Width * 0.75f;
-    float WorldY = Y * Height;
-
-    // ƫư߶
-    if (X % 2 == 1)
-    {
-        WorldY += Height * 0.5f;
-    }
-
-    return FVector(WorldX, WorldY, 0.0f);
+    // ת (ƽ֣ƫư߶)
+    return GetLayout().TileToWorld(X, Y);
 }
 
 void AHexMapRenderer::RenderMap(const TArray<ULandblock*>& MapGrid, int32 MapWidth, int32 MapHeight)
 {
     TileRenderInstances.Empty();
     TileRenderInstances.SetNum(MapWidth * MapHeight);
+    RenderedMapWidth = MapWidth;
+    RenderedMapHeight = MapHeight;
+    RenderedChunkSize = FMath::Max(ChunkSize, 4);
+    RenderedChunksX = FMath::DivideAndRoundUp(MapWidth, RenderedChunkSize);
+
+    // ʱҪ󶨵
+    CreateFogTexture(MapWidth, MapHeight);
 
     if (!TerrainDataAsset)
     {
@@ -66,7 +87,29 @@ void AHexMapRenderer::RenderMap(const TArray<ULandblock*>& MapGrid, int32 MapWid
 
     if (bUseInstancing)
     {
-        // ʹʵȾܣ
+        // ʹʵȾܣȰռȫ任ÿһ
+        const double PrepStart = FPlatformTime::Seconds();
+
+        FRenderBatches Batches;
+        PrepareRenderBatches(MapGrid, MapWidth, MapHeight, Batches);
+
+        const double CommitStart = FPlatformTime::Seconds();
+
+        CommitRenderBatches(Batches);
+
+        // Ƕ Actor
+        for (int32 Index : Batches.WonderTiles)
+        {
+            TileRenderInstances[Index].Wonder = SpawnWonder(MapGrid[Index], CalculateHexWorldPosition(Index % MapWidth, Index / MapWidth));
+        }
+
+        const double EndTime = FPlatformTime::Seconds();
+        UE_LOG(LogTemp, Log, TEXT("HexMapRenderer: %dx%d render prep %.2f ms, instance commit %.2f ms"),
+            MapWidth, MapHeight, (CommitStart - PrepStart) * 1000.0, (EndTime - CommitStart) * 1000.0);
+    }
+    else
+    {
+        // ʵȾڵԻЧ
         for (int32 Y = 0; Y < MapHeight; Y++)
         {
             for (int32 X = 0; X < MapWidth; X++)
@@ -78,98 +121,280 @@ void AHexMapRenderer::RenderMap(const TArray<ULandblock*>& MapGrid, int32 MapWid
                 if (!Block) continue;
 
                 FVector Position = CalculateHexWorldPosition(X, Y);
-
-                // ӵʵ
-                UHierarchicalInstancedStaticMeshComponent* TerrainComp = GetOrCreateTerrainMeshComponent(Block->Terrain);
-                if (TerrainComp)
+                AActor* TileActor = SpawnTileActor(Block, Position);
+                if (TileActor)
                 {
-                    FTransform Transform(FRotator::ZeroRotator, Position, FVector(1.0f));
-                    int32 InstIdx = TerrainComp->AddInstance(Transform);
-
-                    // ¼
-                    if (Index < TileRenderInstances.Num())
-                    {
-                        TileRenderInstances[Index] = { TerrainComp, InstIdx };
-                    }
+                    SpawnedTileActors.Add(TileActor);
                 }
+            }
+        }
+    }
 
+    UE_LOG(LogTemp, Log, TEXT("HexMapRenderer: Map rendering complete"));
+}
 
+void AHexMapRenderer::PrepareRenderBatches(const TArray<ULandblock*>& MapGrid, int32 MapWidth, int32 MapHeight, FRenderBatches& OutBatches,
+    EParallelForFlags ParallelFlags) const
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(AHexMapRenderer::PrepareRenderBatches);
+
+    if (MapGrid.Num() < MapWidth * MapHeight) return;
 
-                // ӵòʵУ
-                if (Block->Landform != ELandform::None)
+    constexpr int32 NumTypes = 256;
+
+    // ÿֻһʾݣûͲʵ (Ĵһ)
+    const bool bHasTerrainMesh = TerrainDataAsset->HexBaseMesh != nullptr;
+    const FLandformDisplayData* LandformData[NumTypes] = {};
+    const FBuildingDisplayData* BuildingData[NumTypes] = {};
+    for (int32 Type = 1; Type < NumTypes; Type++)
+    {
+        const FLandformDisplayData* Landform = TerrainDataAsset->FindLandformDisplayData((ELandform)Type);
+        LandformData[Type] = Landform && Landform->Mesh ? Landform : nullptr;
+
+        const FBuildingDisplayData* Building = BuildingDataAsset ? BuildingDataAsset->FindBuildingDisplayData((EBuildingType)Type) : nullptr;
+        BuildingData[Type] = Building && Building->Mesh ? Building : nullptr;
+    }
+
+    const int32 Size = FMath::Max(ChunkSize, 4);
+    const int32 ChunksX = FMath::DivideAndRoundUp(MapWidth, Size);
+    const int32 ChunksY = FMath::DivideAndRoundUp(MapHeight, Size);
+    const FHexLayout Layout = GetLayout();
+
+    // ÿһзֿ飬дԼбֻ任ֻȡڵؿ鱾
+    TArray<FRenderBatches> RowBatches;
+    RowBatches.SetNum(ChunksY);
+
+    ParallelFor(ChunksY, [&](int32 ChunkY)
+    {
+        FRenderBatches& RowBatch = RowBatches[ChunkY];
+        for (int32 ChunkX = 0; ChunkX < ChunksX; ChunkX++)
+        {
+            const int32 Chunk = ChunkY * ChunksX + ChunkX;
+            const int32 MinX = ChunkX * Size;
+            const int32 MinY = ChunkY * Size;
+            const int32 MaxX = FMath::Min(MinX + Size, MapWidth);
+            const int32 MaxY = FMath::Min(MinY + Size, MapHeight);
+
+            // 1. ͳƿÿֵΡòĵؿ
+            int32 Counts[NumTileRenderLayers][NumTypes] = {};
+            for (int32 Y = MinY; Y < MaxY; Y++)
+            {
+                for (int32 X = MinX; X < MaxX; X++)
                 {
-                    UHierarchicalInstancedStaticMeshComponent* LandformComp = GetOrCreateLandformMeshComponent(Block->Landform);
-                    if (LandformComp)
-                    {
-                        FLandformDisplayData LandformData = TerrainDataAsset->GetLandformDisplayData(Block->Landform);
+                    const int32 Index = Y * MapWidth + X;
+                    const ULandblock* Block = MapGrid[Index];
+                    if (!Block) continue;
 
-                        FRotator Rotation = FRotator::ZeroRotator;
-                        if (LandformData.bRandomRotation)
-                        {
-                            Rotation.Yaw = FMath::RandRange(0.0f, 360.0f);
-                        }
+                    Counts[TerrainLayer][(uint8)Block->Terrain]++;
+                    Counts[LandformLayer][(uint8)Block->Landform]++;
+                    Counts[BuildingLayer][(uint8)GetDisplayedBuilding(Index, Block)]++;
 
-                        FVector LandformPos = Position + FVector(0, 0, LandformData.HeightOffset);
-                        FTransform Transform(Rotation, LandformPos, LandformData.MeshScale);
-                        LandformComp->AddInstance(Transform);
+                    if (Block->WonderType != EWonderType::None)
+                    {
+                        RowBatch.WonderTiles.Add(Index);
                     }
                 }
+            }
 
-                // --- Ⱦ߼ ---
-                if (Block->Building && Block->Building->Type != EBuildingType::None && BuildingDataAsset)
+            // 2. Ϊÿ () Ԥ (¼±꣬ݺȻЧ)
+            int32 BatchIndices[NumTileRenderLayers][NumTypes];
+            for (int32 Layer = 0; Layer < NumTileRenderLayers; Layer++)
+            {
+                for (int32 Type = 0; Type < NumTypes; Type++)
                 {
-                    UHierarchicalInstancedStaticMeshComponent* BuildingComp = GetOrCreateBuildingMeshComponent(Block->Building->Type);
+                    BatchIndices[Layer][Type] = INDEX_NONE;
+
+                    const int32 Count = Counts[Layer][Type];
+                    if (Count == 0) continue;
+
+                    const bool bHasMesh = Layer == TerrainLayer ? bHasTerrainMesh
+                        : Layer == LandformLayer ? LandformData[Type] != nullptr
+                        : BuildingData[Type] != nullptr;
+                    if (!bHasMesh) continue;
+
+                    BatchIndices[Layer][Type] = RowBatch.Layers[Layer].AddDefaulted();
+                    FInstanceBatch& Batch = RowBatch.Layers[Layer].Last();
+                    Batch.Chunk = Chunk;
+                    Batch.Type = (uint8)Type;
+                    Batch.Transforms.Reserve(Count);
+                    Batch.TileIndices.Reserve(Count);
+                }
+            }
 
-                    if (BuildingComp)
-                    {
-                        FBuildingDisplayData BData = BuildingDataAsset->GetBuildingDisplayData(Block->Building->Type);
+            // 3. ռ任
+            for (int32 Y = MinY; Y < MaxY; Y++)
+            {
+                for (int32 X = MinX; X < MaxX; X++)
+                {
+                    const int32 Index = Y * MapWidth + X;
+                    const ULandblock* Block = MapGrid[Index];
+                    if (!Block) continue;
 
-                        FRotator Rotation = FRotator::ZeroRotator;
-                        if (BData.bRandomRotation)
-                        {
-                            Rotation.Yaw = FMath::RandRange(0.0f, 360.0f);
-                        }
+                    const FVector Position = Layout.TileToWorld(X, Y);
 
-                        // ͨڵò֮ϣжĸ߶ƫ
-                        FVector BuildingPos = Position + FVector(0, 0, BData.HeightOffset);
-                        FTransform Transform(Rotation, BuildingPos, BData.MeshScale);
+                    const int32 TerrainBatch = BatchIndices[TerrainLayer][(uint8)Block->Terrain];
+                    if (TerrainBatch != INDEX_NONE)
+                    {
+                        FInstanceBatch& Batch = RowBatch.Layers[TerrainLayer][TerrainBatch];
+                        Batch.Transforms.Emplace(FRotator::ZeroRotator, Position, FVector(1.0f));
+                        Batch.TileIndices.Add(Index);
+                    }
 
-                        BuildingComp->AddInstance(Transform);
+                    const int32 LandformBatch = BatchIndices[LandformLayer][(uint8)Block->Landform];
+                    if (LandformBatch != INDEX_NONE)
+                    {
+                        FInstanceBatch& Batch = RowBatch.Layers[LandformLayer][LandformBatch];
+                        Batch.Transforms.Add(MakeLandformTransform(Index, Position, *LandformData[(uint8)Block->Landform]));
+                        Batch.TileIndices.Add(Index);
                     }
-                }
 
-                // Ƿ
-                if (Block && Block->WonderType != EWonderType::None)
-                {
-                    SpawnWonder(Block, Position);
+                    const EBuildingType BuildingType = GetDisplayedBuilding(Index, Block);
+                    const int32 BuildingBatch = BatchIndices[BuildingLayer][(uint8)BuildingType];
+                    if (BuildingBatch != INDEX_NONE)
+                    {
+                        FInstanceBatch& Batch = RowBatch.Layers[BuildingLayer][BuildingBatch];
+                        Batch.Transforms.Add(MakeBuildingTransform(Index, Position, *BuildingData[(uint8)BuildingType]));
+                        Batch.TileIndices.Add(Index);
+                    }
                 }
             }
         }
+    }, ParallelFlags);
+
+    // ֿе˳ϲ߳͵˳޹
+    for (FRenderBatches& RowBatch : RowBatches)
+    {
+        for (int32 Layer = 0; Layer < NumTileRenderLayers; Layer++)
+        {
+            OutBatches.Layers[Layer].Append(MoveTemp(RowBatch.Layers[Layer]));
+        }
+        OutBatches.WonderTiles.Append(RowBatch.WonderTiles);
     }
-    else
+}
+
+void AHexMapRenderer::CommitRenderBatches(const FRenderBatches& Batches)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(AHexMapRenderer::CommitRenderBatches);
+
+    for (int32 Layer = 0; Layer < NumTileRenderLayers; Layer++)
     {
-        // ʵȾڵԻЧ
-        for (int32 Y = 0; Y < MapHeight; Y++)
+        for (const FInstanceBatch& Batch : Batches.Layers[Layer])
         {
-            for (int32 X = 0; X < MapWidth; X++)
-            {
-                int32 Index = Y * MapWidth + X;
-                if (Index >= MapGrid.Num()) continue;
+            UHierarchicalInstancedStaticMeshComponent* Component = GetOrCreateLayerComponent((ETileRenderLayer)Layer, Batch.Type, Batch.Chunk);
+            if (!Component) continue;
 
-                ULandblock* Block = MapGrid[Index];
-                if (!Block) continue;
+            RegisterInstances((ETileRenderLayer)Layer, Component, Batch.TileIndices, AddInstancesBatched(Component, Batch.Transforms, true));
+        }
+    }
+}
 
-                FVector Position = CalculateHexWorldPosition(X, Y);
-                AActor* TileActor = SpawnTileActor(Block, Position);
-                if (TileActor)
+UHierarchicalInstancedStaticMeshComponent* AHexMapRenderer::GetOrCreateLayerComponent(ETileRenderLayer Layer, uint8 Type, int32 Chunk)
+{
+    switch (Layer)
+    {
+        case TerrainLayer:  return GetOrCreateTerrainMeshComponent((ETerrain)Type, Chunk);
+        case LandformLayer: return GetOrCreateLandformMeshComponent((ELandform)Type, Chunk);
+        case BuildingLayer: return GetOrCreateBuildingMeshComponent((EBuildingType)Type, Chunk);
+        default:            return nullptr;
+    }
+}
+
+void AHexMapRenderer::RegisterInstances(ETileRenderLayer Layer, UHierarchicalInstancedStaticMeshComponent* Component, const TArray<int32>& TileIndices, const TArray<int32>& InstanceIndices)
+{
+    TArray<int32>& Owners = InstanceTiles.FindOrAdd(Component);
+    Owners.SetNum(Component->GetInstanceCount());
+
+    for (int32 i = 0; i < InstanceIndices.Num(); i++)
+    {
+        const int32 TileIndex = TileIndices[i];
+        TileRenderInstances[TileIndex].Layers[Layer] = { Component, InstanceIndices[i] };
+        Owners[InstanceIndices[i]] = TileIndex;
+    }
+}
+
+float AHexMapRenderer::GetTileYaw(int32 TileIndex, ETileRenderLayer Layer)
+{
+    // õؿϣ򣺽ɸ̵֣߳޹أҲϷȫ
+    const uint32 Hash = FFixedPointNoise::Hash((uint32)TileIndex, (uint32)Layer, 0x52454E44u);
+    return (Hash >> 8) * (360.0f / 16777216.0f);
+}
+
+FTransform AHexMapRenderer::MakeLandformTransform(int32 TileIndex, const FVector& Position, const FLandformDisplayData& Data)
+{
+    FRotator Rotation = FRotator::ZeroRotator;
+    if (Data.bRandomRotation)
+    {
+        Rotation.Yaw = GetTileYaw(TileIndex, LandformLayer);
+    }
+
+    return FTransform(Rotation, Position + FVector(0, 0, Data.HeightOffset), Data.MeshScale);
+}
+
+FTransform AHexMapRenderer::MakeBuildingTransform(int32 TileIndex, const FVector& Position, const FBuildingDisplayData& Data)
+{
+    FRotator Rotation = FRotator::ZeroRotator;
+    if (Data.bRandomRotation)
+    {
+        Rotation.Yaw = GetTileYaw(TileIndex, BuildingLayer);
+    }
+
+    // ͨڵò֮ϣжĸ߶ƫ
+    return FTransform(Rotation, Position + FVector(0, 0, Data.HeightOffset), Data.MeshScale);
+}
+
+TArray<int32> AHexMapRenderer::AddInstancesBatched(UHierarchicalInstancedStaticMeshComponent* Component, const TArray<FTransform>& Transforms, bool bReturnIndices)
+{
+    const bool bAutoRebuild = Component->bAutoRebuildTreeOnInstanceChanges;
+    Component->bAutoRebuildTreeOnInstanceChanges = false;
+
+    TArray<int32> InstanceIndices = Component->AddInstances(Transforms, bReturnIndices);
+
+    Component->bAutoRebuildTreeOnInstanceChanges = bAutoRebuild;
+    Component->BuildTreeIfOutdated(/*Async*/ true, /*ForceUpdate*/ false);
+
+    return InstanceIndices;
+}
+
+void AHexMapRenderer::RunRenderPrepBenchmark(const TArray<ULandblock*>& MapGrid, int32 MapWidth, int32 MapHeight, int32 NumRuns) const
+{
+    if (!TerrainDataAsset || NumRuns <= 0) return;
+
+    int32 NumInstances = 0;
+    int32 NumComponents = 0;
+    double Elapsed[2] = {};
+    uint32 Checksums[2] = {};
+    const EParallelForFlags Modes[2] = { EParallelForFlags::ForceSingleThread, EParallelForFlags::None };
+
+    for (int32 Mode = 0; Mode < 2; Mode++)
+    {
+        const double StartTime = FPlatformTime::Seconds();
+
+        for (int32 Run = 0; Run < NumRuns; Run++)
+        {
+            FRenderBatches Batches;
+            PrepareRenderBatches(MapGrid, MapWidth, MapHeight, Batches, Modes[Mode]);
+
+            NumInstances = 0;
+            NumComponents = 0;
+            Checksums[Mode] = 0;
+            for (const TArray<FInstanceBatch>& LayerBatches : Batches.Layers)
+            {
+                NumComponents += LayerBatches.Num();
+                for (const FInstanceBatch& Batch : LayerBatches)
                 {
-                    SpawnedTileActors.Add(TileActor);
+                    NumInstances += Batch.Transforms.Num();
+                    Checksums[Mode] = FCrc::MemCrc32(Batch.Transforms.GetData(), Batch.Transforms.Num() * sizeof(FTransform), Checksums[Mode]);
                 }
             }
         }
+
+        Elapsed[Mode] = (FPlatformTime::Seconds() - StartTime) / NumRuns;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("HexMapRenderer: Map rendering complete"));
+    UE_LOG(LogTemp, Log, TEXT("Render prep benchmark %4dx%-4d: %7d tiles, %7d instances in %5d chunk components, 1 thread %.3f ms, parallel %.3f ms (x%.2f)%s"),
+        MapWidth, MapHeight, MapWidth * MapHeight, NumInstances, NumComponents,
+        Elapsed[0] * 1000.0, Elapsed[1] * 1000.0, Elapsed[1] > 0.0 ? Elapsed[0] / Elapsed[1] : 0.0,
+        Checksums[0] == Checksums[1] ? TEXT("") : TEXT(" (MISMATCH)"));
 }
 
 void AHexMapRenderer::ClearMap()
@@ -225,13 +450,114 @@ void AHexMapRenderer::ClearMap()
         }
     }
     SpawnedTileActors.Empty();
+
+    // ٣ʵ¼
+    for (FHexTileRenderInstances& Instances : TileRenderInstances)
+    {
+        Instances = FHexTileRenderInstances();
+    }
+    InstanceTiles.Reset();
+    FogMaterialInstances.Reset();
+
+    ClearMovementRange();
 }
 
 void AHexMapRenderer::UpdateTile(ULandblock* Landblock)
 {
-    // TODO: ʵֵؿĸ
-    // Ҫ׷ÿؿӦʵ
-    UE_LOG(LogTemp, Warning, TEXT("UpdateTile not fully implemented yet"));
+    TRACE_CPUPROFILER_EVENT_SCOPE(AHexMapRenderer::UpdateTile);
+
+    if (!Landblock || !TerrainDataAsset || !bUseInstancing || RenderedMapWidth <= 0) return;
+
+    const int32 Index = Landblock->Y * RenderedMapWidth + Landblock->X;
+    if (!TileRenderInstances.IsValidIndex(Index)) return;
+
+    FHexTileRenderInstances& Instances = TileRenderInstances[Index];
+    const FVector Position = CalculateHexWorldPosition(Landblock->X, Landblock->Y);
+    const int32 Chunk = GetTileChunk(Landblock->X, Landblock->Y);
+
+    // ͼֻ () ıʱ滻ʵͲͼ㱣ԭֻڿؽ㼶
+    UHierarchicalInstancedStaticMeshComponent* TerrainComp = GetOrCreateTerrainMeshComponent(Landblock->Terrain, Chunk);
+    if (Instances.Layers[TerrainLayer].Component != TerrainComp)
+    {
+        SetTileInstance(Index, TerrainLayer, TerrainComp, FTransform(FRotator::ZeroRotator, Position, FVector(1.0f)));
+    }
+
+    UHierarchicalInstancedStaticMeshComponent* LandformComp = nullptr;
+    if (Landblock->Landform != ELandform::None)
+    {
+        LandformComp = GetOrCreateLandformMeshComponent(Landblock->Landform, Chunk);
+    }
+    if (Instances.Layers[LandformLayer].Component != LandformComp)
+    {
+        const FLandformDisplayData* Data = LandformComp ? TerrainDataAsset->FindLandformDisplayData(Landblock->Landform) : nullptr;
+        SetTileInstance(Index, LandformLayer, LandformComp, Data ? MakeLandformTransform(Index, Position, *Data) : FTransform::Identity);
+    }
+
+    const EBuildingType BuildingType = GetDisplayedBuilding(Index, Landblock);
+    UHierarchicalInstancedStaticMeshComponent* BuildingComp = nullptr;
+    if (BuildingType != EBuildingType::None)
+    {
+        BuildingComp = GetOrCreateBuildingMeshComponent(BuildingType, Chunk);
+    }
+    if (Instances.Layers[BuildingLayer].Component != BuildingComp)
+    {
+        const FBuildingDisplayData* Data = BuildingComp ? BuildingDataAsset->FindBuildingDisplayData(BuildingType) : nullptr;
+        SetTileInstance(Index, BuildingLayer, BuildingComp, Data ? MakeBuildingTransform(Index, Position, *Data) : FTransform::Identity);
+    }
+
+    // ۣ͸ıʱپ Actor µ
+    AWonder* Wonder = Instances.Wonder.Get();
+    const EWonderType CurrentWonder = Wonder ? Wonder->WonderType : EWonderType::None;
+    if (CurrentWonder != Landblock->WonderType)
+    {
+        if (Wonder)
+        {
+            SpawnedWonderActors.RemoveSwap(Wonder);
+            Wonder->Destroy();
+        }
+        Instances.Wonder = Landblock->WonderType != EWonderType::None ? SpawnWonder(Landblock, Position) : nullptr;
+    }
+}
+
+void AHexMapRenderer::SetTileInstance(int32 TileIndex, ETileRenderLayer Layer, UHierarchicalInstancedStaticMeshComponent* Component, const FTransform& Transform)
+{
+    RemoveTileInstance(TileIndex, Layer);
+    if (!Component) return;
+
+    const int32 InstanceIndex = Component->AddInstance(Transform);
+    TileRenderInstances[TileIndex].Layers[Layer] = { Component, InstanceIndex };
+
+    TArray<int32>& Owners = InstanceTiles.FindOrAdd(Component);
+    if (Owners.Num() <= InstanceIndex)
+    {
+        Owners.SetNum(InstanceIndex + 1);
+    }
+    Owners[InstanceIndex] = TileIndex;
+}
+
+void AHexMapRenderer::RemoveTileInstance(int32 TileIndex, ETileRenderLayer Layer)
+{
+    FHexRenderInstance& Instance = TileRenderInstances[TileIndex].Layers[Layer];
+    UHierarchicalInstancedStaticMeshComponent* Component = Instance.Component;
+    if (!Component) return;
+
+    const int32 Removed = Instance.InstanceIndex;
+    Instance = FHexRenderInstance();
+
+    TArray<int32>* Owners = InstanceTiles.Find(Component);
+    if (!Owners || !Owners->IsValidIndex(Removed)) return;
+
+    Component->RemoveInstance(Removed);
+
+    // HISM һʵƵɾλã¸ʵؿļ¼
+    const int32 Last = Owners->Num() - 1;
+    if (Removed != Last)
+    {
+        const int32 MovedTile = (*Owners)[Last];
+        (*Owners)[Removed] = MovedTile;
+        TileRenderInstances[MovedTile].Layers[Layer].InstanceIndex = Removed;
+    }
+    Owners->Pop(EAllowShrinking::No);
 }
 
 AActor* AHexMapRenderer::SpawnTileActor(ULandblock* Landblock, const FVector& Position)
@@ -265,18 +591,19 @@ AActor* AHexMapRenderer::SpawnTileActor(ULandblock* Landblock, const FVector& Po
     return TileActor;
 }
 
-UHierarchicalInstancedStaticMeshComponent* AHexMapRenderer::GetOrCreateTerrainMeshComponent(ETerrain TerrainType)
+UHierarchicalInstancedStaticMeshComponent* AHexMapRenderer::GetOrCreateTerrainMeshComponent(ETerrain TerrainType, int32 Chunk)
 {
     if (!TerrainDataAsset || !TerrainDataAsset->HexBaseMesh) return nullptr;
 
     // ǷѴ
-    if (UHierarchicalInstancedStaticMeshComponent** Found = TerrainMeshComponents.Find(TerrainType))
+    const int32 Key = MakeChunkKey(Chunk, (uint8)TerrainType);
+    if (UHierarchicalInstancedStaticMeshComponent** Found = TerrainMeshComponents.Find(Key))
     {
         return *Found;
     }
 
     // µʵ
-    FName ComponentName = FName(*FString::Printf(TEXT("TerrainMesh_%d"), (int32)TerrainType));
+    FName ComponentName = FName(*FString::Printf(TEXT("TerrainMesh_%d_%d"), (int32)TerrainType, Chunk));
     UHierarchicalInstancedStaticMeshComponent* NewComp = NewObject<UHierarchicalInstancedStaticMeshComponent>(this, ComponentName);
 
     NewComp->SetStaticMesh(TerrainDataAsset->HexBaseMesh);
@@ -288,84 +615,88 @@ UHierarchicalInstancedStaticMeshComponent* AHexMapRenderer::GetOrCreateTerrainMe
     }
 
     NewComp->SetupAttachment(RootComponent);
-    NewComp->NumCustomDataFloats = 1; // Զͨ
     NewComp->RegisterComponent();
+    ApplyFogMaterial(NewComp);
 
     // Ż
     NewComp->SetCullDistances(10000, 50000);
     NewComp->bUseAsOccluder = false;
 
-    TerrainMeshComponents.Add(TerrainType, NewComp);
+    TerrainMeshComponents.Add(Key, NewComp);
 
     return NewComp;
 }
 
-UHierarchicalInstancedStaticMeshComponent* AHexMapRenderer::GetOrCreateLandformMeshComponent(ELandform LandformType)
+UHierarchicalInstancedStaticMeshComponent* AHexMapRenderer::GetOrCreateLandformMeshComponent(ELandform LandformType, int32 Chunk)
 {
     if (!TerrainDataAsset) return nullptr;
 
-    FLandformDisplayData LandformData = TerrainDataAsset->GetLandformDisplayData(LandformType);
-    if (!LandformData.Mesh) return nullptr;
-
     // ǷѴ
-    if (UHierarchicalInstancedStaticMeshComponent** Found = LandformMeshComponents.Find(LandformType))
+    const int32 Key = MakeChunkKey(Chunk, (uint8)LandformType);
+    if (UHierarchicalInstancedStaticMeshComponent** Found = LandformMeshComponents.Find(Key))
     {
         return *Found;
     }
 
+    const FLandformDisplayData* LandformData = TerrainDataAsset->FindLandformDisplayData(LandformType);
+    if (!LandformData || !LandformData->Mesh) return nullptr;
+
     // µʵ
-    FName ComponentName = FName(*FString::Printf(TEXT("LandformMesh_%d"), (int32)LandformType));
+    FName ComponentName = FName(*FString::Printf(TEXT("LandformMesh_%d_%d"), (int32)LandformType, Chunk));
     UHierarchicalInstancedStaticMeshComponent* NewComp = NewObject<UHierarchicalInstancedStaticMeshComponent>(this, ComponentName);
 
-    NewComp->SetStaticMesh(LandformData.Mesh);
+    NewComp->SetStaticMesh(LandformData->Mesh);
 
-    if (LandformData.OverlayMaterial)
+    if (LandformData->OverlayMaterial)
     {
-        NewComp->SetMaterial(0, LandformData.OverlayMaterial);
+        NewComp->SetMaterial(0, LandformData->OverlayMaterial);
     }
 
     NewComp->SetupAttachment(RootComponent);
     NewComp->RegisterComponent();
+    ApplyFogMaterial(NewComp);
 
     // Ż
     NewComp->SetCullDistances(8000, 40000);
 
-    LandformMeshComponents.Add(LandformType, NewComp);
+    LandformMeshComponents.Add(Key, NewComp);
 
     return NewComp;
 }
 
-UHierarchicalInstancedStaticMeshComponent* AHexMapRenderer::GetOrCreateBuildingMeshComponent(EBuildingType BuildingType)
+UHierarchicalInstancedStaticMeshComponent* AHexMapRenderer::GetOrCreateBuildingMeshComponent(EBuildingType BuildingType, int32 Chunk)
 {
     if (!BuildingDataAsset) return nullptr;
 
-    FBuildingDisplayData BData = BuildingDataAsset->GetBuildingDisplayData(BuildingType);
-    if (!BData.Mesh) return nullptr;
-
     // 黺
-    if (UHierarchicalInstancedStaticMeshComponent** Found = BuildingMeshComponents.Find(BuildingType))
+    const int32 Key = MakeChunkKey(Chunk, (uint8)BuildingType);
+    if (UHierarchicalInstancedStaticMeshComponent** Found = BuildingMeshComponents.Find(Key))
     {
         return *Found;
     }
 
+    const FBuildingDisplayData* BData = BuildingDataAsset->FindBuildingDisplayData(BuildingType);
+    if (!BData || !BData->Mesh) return nullptr;
+
     // 
-    FName ComponentName = FName(*FString::Printf(TEXT("BuildingMesh_%d"), (int32)BuildingType));
+    FName ComponentName = FName(*FString::Printf(TEXT("BuildingMesh_%d_%d"), (int32)BuildingType, Chunk));
     UHierarchicalInstancedStaticMeshComponent* NewComp = NewObject<UHierarchicalInstancedStaticMeshComponent>(this, ComponentName);
 
-    NewComp->SetStaticMesh(BData.Mesh);
+    NewComp->SetStaticMesh(BData->Mesh);
     NewComp->SetupAttachment(RootComponent);
     NewComp->RegisterComponent();
+    ApplyFogMaterial(NewComp);
 
     // ޳루ȵСԸ޳
     NewComp->SetCullDistances(5000, 20000);
 
-    BuildingMeshComponents.Add(BuildingType, NewComp);
+    BuildingMeshComponents.Add(Key, NewComp);
     return NewComp;
 }
 
-void AHexMapRenderer::SpawnWonder(ULandblock* Block, const FVector& Position)
+AWonder* AHexMapRenderer::SpawnWonder(ULandblock* Block, const FVector& Position)
 {
-    if (!WonderDataAsset || !Block) return;
+    if (!WonderDataAsset || !Block) return nullptr;
 
     FWonderDisplayData Data = WonderDataAsset->GetWonderDisplayData(Block->WonderType);
 
@@ -395,44 +726,241 @@ void AHexMapRenderer::SpawnWonder(ULandblock* Block, const FVector& Position)
         }
         //  BP ࣬ͨ visuals Ѿ BP úˣҲ InitVisuals
 
+        ApplyFogMaterial(NewWonder->MeshComponent);
+
         SpawnedWonderActors.Add(NewWonder);
     }
+
+    return NewWonder;
 }
 
 void AHexMapRenderer::UpdateFogOfWarVisuals(const TArray<ULandblock*>& MapGrid, int32 CurrentPlayerIndex)
 {
-    if (TileRenderInstances.Num() != MapGrid.Num()) return;
+    if (FogTexels.Num() != MapGrid.Num()) return;
 
+    // ֻдأκʵ״̬δĵؿ鲻ᱻϴ
     for (int32 i = 0; i < MapGrid.Num(); i++)
     {
-        ULandblock* Block = MapGrid[i];
-        if (!Block) continue;
+        if (ULandblock* Block = MapGrid[i])
+        {
+            SetFogTexel(i, Block->GetVisibility(CurrentPlayerIndex));
+        }
+    }
 
-        FHexRenderInstance& RenderInfo = TileRenderInstances[i];
-        if (!RenderInfo.Component) continue;
+    FlushFogTexture();
+}
 
-        EVisibilityState State = Block->GetVisibility(CurrentPlayerIndex);
+void AHexMapRenderer::UpdateTileVisibility(const TArray<ULandblock*>& MapGrid, const TArray<int32>& TileIndices, int32 CurrentPlayerIndex)
+{
+    if (FogTexels.Num() != MapGrid.Num()) return;
 
-        // ʹ CustomData[0] Ұ״̬
-        // 0.0 = Unexplored (ػɫ)
-        // 0.5 = FogOfWar (䰵)
-        // 1.0 = Visible ()
+    for (int32 Index : TileIndices)
+    {
+        if (MapGrid.IsValidIndex(Index) && MapGrid[Index])
+        {
+            SetFogTexel(Index, MapGrid[Index]->GetVisibility(CurrentPlayerIndex));
+        }
+    }
 
-        float VisualValue = 0.0f;
-        switch (State)
+    FlushFogTexture();
+}
+
+void AHexMapRenderer::SetTileMemory(const FHexTileMemory* Memory, int32 PlayerIndex)
+{
+    TileMemory = Memory;
+    TileMemoryPlayer = PlayerIndex;
+}
+
+EBuildingType AHexMapRenderer::GetDisplayedBuilding(int32 Index, const ULandblock* Block) const
+{
+    if (TileMemory)
+    {
+        if (const FHexTileSnapshot* Remembered = TileMemory->Find(TileMemoryPlayer, Index))
+        {
+            return Remembered->Building;
+        }
+    }
+    return Block->Building ? Block->Building->Type : EBuildingType::None;
+}
+
+void AHexMapRenderer::CreateFogTexture(int32 MapWidth, int32 MapHeight)
+{
+    if (MapWidth <= 0 || MapHeight <= 0) return;
+
+    FogTexels.Init(0, MapWidth * MapHeight);
+    FogDirtySpans.Init(FIntPoint(MapWidth, -1), MapHeight);
+    FogDirtyRows.Reset();
+
+    // ߴ粻ʱʵϵñЧ
+    if (!FogTexture || FogTexture->GetSizeX() != MapWidth || FogTexture->GetSizeY() != MapHeight)
+    {
+        FogTexture = UTexture2D::CreateTransient(MapWidth, MapHeight, PF_G8, TEXT("HexFogTexture"));
+        if (!FogTexture) return;
+
+        // ÿضӦһؿ飺X ͼһ
+        FogTexture->Filter = TF_Nearest;
+        FogTexture->SRGB = false;
+        FogTexture->AddressX = TA_Wrap;
+        FogTexture->AddressY = TA_Clamp;
+        FogTexture->UpdateResource();
+    }
+
+    // ȫΪδ̽
+    for (int32 Row = 0; Row < MapHeight; Row++)
+    {
+        FogDirtySpans[Row] = FIntPoint(0, MapWidth - 1);
+        FogDirtyRows.Add(Row);
+    }
+    FlushFogTexture();
+}
+
+void AHexMapRenderer::SetFogTexel(int32 Index, EVisibilityState State)
+{
+    const uint8 Value = GetFogTexelValue(State);
+    if (FogTexels[Index] == Value) return;
+
+    FogTexels[Index] = Value;
+
+    const int32 X = Index % RenderedMapWidth;
+    const int32 Row = Index / RenderedMapWidth;
+    FIntPoint& Span = FogDirtySpans[Row];
+    if (Span.Y < 0)
+    {
+        FogDirtyRows.Add(Row);
+    }
+    Span.X = FMath::Min(Span.X, X);
+    Span.Y = FMath::Max(Span.Y, X);
+}
+
+void AHexMapRenderer::FlushFogTexture()
+{
+    if (FogDirtyRows.Num() == 0) return;
+
+    if (!FogTexture)
+    {
+        for (int32 Row : FogDirtyRows) FogDirtySpans[Row] = FIntPoint(RenderedMapWidth, -1);
+        FogDirtyRows.Reset();
+        return;
+    }
+
+    // ֻиǵзΧȾ߳ϴɺɻصͷ
+    int32 MinRow = MAX_int32;
+    int32 MaxRow = 0;
+    for (int32 Row : FogDirtyRows)
+    {
+        MinRow = FMath::Min(MinRow, Row);
+        MaxRow = FMath::Max(MaxRow, Row);
+    }
+
+    const int32 NumRows = MaxRow - MinRow + 1;
+    const bool bFullUpload = NumRows == RenderedMapHeight && FogDirtyRows.Num() == RenderedMapHeight;
+    const int32 NumRegions = bFullUpload ? 1 : FogDirtyRows.Num();
+
+    FUpdateTextureRegion2D* Regions = new FUpdateTextureRegion2D[NumRegions];
+    if (bFullUpload)
+    {
+        Regions[0] = FUpdateTextureRegion2D(0, 0, 0, 0, RenderedMapWidth, RenderedMapHeight);
+    }
+    else
+    {
+        for (int32 i = 0; i < NumRegions; i++)
         {
-            case EVisibilityState::Unexplored: VisualValue = 0.0f; break;
-            case EVisibilityState::FogOfWar:   VisualValue = 0.5f; break;
-            case EVisibilityState::Visible:    VisualValue = 1.0f; break;
+            const int32 Row = FogDirtyRows[i];
+            const FIntPoint& Span = FogDirtySpans[Row];
+            Regions[i] = FUpdateTextureRegion2D(Span.X, Row, Span.X, Row - MinRow, Span.Y - Span.X + 1, 1);
         }
+    }
+
+    const int32 NumBytes = NumRows * RenderedMapWidth;
+    uint8* SrcData = (uint8*)FMemory::Malloc(NumBytes);
+    FMemory::Memcpy(SrcData, FogTexels.GetData() + MinRow * RenderedMapWidth, NumBytes);
 
-        // ʵ (Ҫȷ NumCustomDataFloats >= 1)
-        RenderInfo.Component->SetCustomDataValue(RenderInfo.InstanceIndex, 0, VisualValue, true);
+    FogTexture->UpdateTextureRegions(0, NumRegions, Regions, RenderedMapWidth, 1, SrcData,
+        [](uint8* Data, const FUpdateTextureRegion2D* InRegions)
+        {
+            FMemory::Free(Data);
+            delete[] InRegions;
+        });
+
+    for (int32 Row : FogDirtyRows)
+    {
+        FogDirtySpans[Row] = FIntPoint(RenderedMapWidth, -1);
     }
+    FogDirtyRows.Reset();
+}
 
-    // Ⱦ״̬࣬
-    for (auto& Pair : TerrainMeshComponents)
+void AHexMapRenderer::ApplyFogMaterial(UMeshComponent* Component)
+{
+    if (!Component || !FogTexture) return;
+
+    const FHexLayout Layout = GetLayout();
+    const FLinearColor FogLayout(Layout.GetTileWidth() * 0.75f, Layout.GetTileHeight(), RenderedMapWidth, RenderedMapHeight);
+    const FLinearColor FogOrigin(GetActorLocation());
+
+    for (int32 MaterialIndex = 0; MaterialIndex < Component->GetNumMaterials(); MaterialIndex++)
+    {
+        UMaterialInterface* Material = Component->GetMaterial(MaterialIndex);
+        if (!Material) continue;
+
+        UMaterialInstanceDynamic* MID = Cast<UMaterialInstanceDynamic>(Material);
+        if (!MID)
+        {
+            // ͬһʵзֿһ̬ʵ
+            UMaterialInstanceDynamic*& Shared = FogMaterialInstances.FindOrAdd(Material);
+            if (!Shared)
+            {
+                Shared = UMaterialInstanceDynamic::Create(Material, this);
+            }
+            MID = Shared;
+            Component->SetMaterial(MaterialIndex, MID);
+        }
+        if (!MID) continue;
+
+        MID->SetTextureParameterValue(FogTextureParam, FogTexture);
+        MID->SetVectorParameterValue(FogLayoutParam, FogLayout);
+        MID->SetVectorParameterValue(FogOriginParam, FogOrigin);
+    }
+}
+
+void AHexMapRenderer::ShowMovementRange(const TArray<int32>& TileIndices)
+{
+    if (RenderedMapWidth <= 0) return;
+
+    if (!HighlightMeshComponent)
+    {
+        UStaticMesh* Mesh = HighlightMesh ? HighlightMesh : (TerrainDataAsset ? TerrainDataAsset->HexBaseMesh : nullptr);
+        if (!Mesh) return;
+
+        HighlightMeshComponent = NewObject<UInstancedStaticMeshComponent>(this, TEXT("MovementRangeHighlight"));
+        HighlightMeshComponent->SetStaticMesh(Mesh);
+        if (HighlightMaterial)
+        {
+            HighlightMeshComponent->SetMaterial(0, HighlightMaterial);
+        }
+        HighlightMeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        HighlightMeshComponent->SetCastShadow(false);
+        HighlightMeshComponent->SetupAttachment(RootComponent);
+        HighlightMeshComponent->RegisterComponent();
+    }
+
+    HighlightMeshComponent->ClearInstances();
+
+    TArray<FTransform> Transforms;
+    Transforms.Reserve(TileIndices.Num());
+    for (int32 Index : TileIndices)
+    {
+        // ΢̧߲СڵϷ
+        const FVector Position = CalculateHexWorldPosition(Index % RenderedMapWidth, Index / RenderedMapWidth) + FVector(0, 0, 5.0f);
+        Transforms.Add(FTransform(FRotator::ZeroRotator, Position, FVector(0.9f, 0.9f, 1.0f)));
+    }
+
+    HighlightMeshComponent->AddInstances(Transforms, false);
+}
+
+void AHexMapRenderer::ClearMovementRange()
+{
+    if (HighlightMeshComponent)
     {
-        if (Pair.Value) Pair.Value->MarkRenderStateDirty();
+        HighlightMeshComponent->ClearInstances();
     }
 }
\ No newline at end of file
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexPathBatch.h"
+#include "Async/Async.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Math/RandomStream.h"
+#include "Misc/Crc.h"
+#include <atomic>
+
+namespace
+{
+    // һĹ״̬Ӽȡһ
+    struct FHexPathBatchState
+    {
+        TSharedRef<const FMovementCostGrid> Snapshot;
+        TArray<FHexPathQuery> Queries;
+        TArray<TPromise<FHexPathBatchResult>> Promises;
+        std::atomic<int32> NextQuery { 0 };
+
+        explicit FHexPathBatchState(const TSharedRef<const FMovementCostGrid>& InSnapshot)
+            : Snapshot(InSnapshot)
+        {
+        }
+
+        void RunWorker()
+        {
+            for (int32 Index = NextQuery++; Index < Queries.Num(); Index = NextQuery++)
+            {
+                FHexPathBatchResult Result;
+                Result.Result = FHexPathfinder::FindPath(*Snapshot, Queries[Index], Result.Path);
+                Promises[Index].SetValue(MoveTemp(Result));
+            }
+        }
+    };
+}
+
+TArray<TFuture<FHexPathBatchResult>> FHexPathBatch::Submit(const TSharedRef<const FMovementCostGrid>& Snapshot, TConstArrayView<FHexPathQuery> Queries, int32 NumWorkers)
+{
+    TSharedRef<FHexPathBatchState, ESPMode::ThreadSafe> State = MakeShared<FHexPathBatchState, ESPMode::ThreadSafe>(Snapshot);
+    State->Queries.Append(Queries.GetData(), Queries.Num());
+    State->Promises.SetNum(Queries.Num());
+
+    TArray<TFuture<FHexPathBatchResult>> Futures;
+    Futures.Reserve(Queries.Num());
+    for (TPromise<FHexPathBatchResult>& Promise : State->Promises)
+    {
+        Futures.Add(Promise.GetFuture());
+    }
+
+    if (Queries.Num() == 0) return Futures;
+
+    if (NumWorkers <= 0)
+    {
+        NumWorkers = FTaskGraphInterface::Get().GetNumWorkerThreads();
+    }
+    NumWorkers = FMath::Clamp(NumWorkers, 1, Queries.Num());
+
+    for (int32 Worker = 0; Worker < NumWorkers; Worker++)
+    {
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [State]()
+        {
+            State->RunWorker();
+        });
+    }
+
+    return Futures;
+}
+
+void FHexPathBatch::RunBenchmark(const TSharedRef<const FMovementCostGrid>& Snapshot, int32 NumQueries, int32 Seed)
+{
+    const FMovementCostGrid& Grid = *Snapshot;
+    if (!Grid.IsValid() || NumQueries <= 0) return;
+
+    FRandomStream Random(Seed);
+
+    TArray<FHexPathQuery> Queries;
+    Queries.Reserve(NumQueries);
+    for (int32 Attempt = 0; Attempt < NumQueries * 64 && Queries.Num() < NumQueries; Attempt++)
+    {
+        FHexPathQuery Query;
+        Query.StartIndex = Random.RandRange(0, Grid.Num() - 1);
+        Query.GoalIndex = Random.RandRange(0, Grid.Num() - 1);
+        if (Grid.Costs[Query.StartIndex] == 0 || Grid.Costs[Query.GoalIndex] == 0) continue;
+
+        // ϲͬƶ
+        Query.MaxMovementPoints = Random.RandRange(2, 4);
+        Query.StartMovementPoints = Query.MaxMovementPoints;
+        Queries.Add(Query);
+    }
+    if (Queries.Num() == 0) return;
+
+    // нУֵȷϲͬ߳½һ
+    auto HashResults = [](TArray<TFuture<FHexPathBatchResult>>& Futures)
+    {
+        uint32 Hash = 0;
+        for (TFuture<FHexPathBatchResult>& Future : Futures)
+        {
+            const FHexPathBatchResult& Result = Future.Get();
+            Hash = FCrc::MemCrc32(&Result.Result.ArrivalTime, sizeof(int32), Hash);
+            Hash = FCrc::MemCrc32(Result.Path.GetData(), Result.Path.Num() * sizeof(int32), Hash);
+        }
+        return Hash;
+    };
+
+    const int32 WorkerCounts[] = { 1, 4, 16 };
+    uint32 ReferenceHash = 0;
+
+    for (int32 NumWorkers : WorkerCounts)
+    {
+        const double StartTime = FPlatformTime::Seconds();
+
+        TArray<TFuture<FHexPathBatchResult>> Futures = Submit(Snapshot, Queries, NumWorkers);
+        for (TFuture<FHexPathBatchResult>& Future : Futures)
+        {
+            Future.Wait();
+        }
+
+        const double Elapsed = FPlatformTime::Seconds() - StartTime;
+        const uint32 Hash = HashResults(Futures);
+        if (NumWorkers == WorkerCounts[0])
+        {
+            ReferenceHash = Hash;
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("Path batch benchmark %dx%d: %d queries, %2d workers: %.2f ms, %.0f paths/sec, results %08x%s"),
+            Grid.Width, Grid.Height, Queries.Num(), NumWorkers, Elapsed * 1000.0,
+            Elapsed > 0.0 ? Queries.Num() / Elapsed : 0.0, Hash,
+            Hash == ReferenceHash ? TEXT("") : TEXT(" (MISMATCH)"));
+    }
+}
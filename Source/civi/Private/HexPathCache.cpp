@@ -0,0 +1,154 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexPathCache.h"
+
+void FHexPathCache::Reset(int32 InWidth, int32 InHeight)
+{
+    Width = InWidth;
+    Height = InHeight;
+    RegionsX = (Width + RegionSize - 1) / RegionSize;
+
+    Entries.Reset();
+    RegionEntries.Reset();
+}
+
+int32 FHexPathCache::GetRegionOfTile(int32 TileIndex) const
+{
+    const int32 X = TileIndex % Width;
+    const int32 Y = TileIndex / Width;
+    return (Y / RegionSize) * RegionsX + X / RegionSize;
+}
+
+bool FHexPathCache::Find(const FHexPathQuery& Query, FHexPathResult& OutResult, TArray<int32>& OutPath)
+{
+    FEntry* Entry = Entries.Find(FHexPathCacheKey(Query));
+    if (!Entry)
+    {
+        Misses++;
+        return false;
+    }
+
+    Hits++;
+    Entry->LastUsed = ++UseCounter;
+
+    OutResult = Entry->Result;
+    OutResult.NodesExpanded = 0;
+    OutPath = Entry->Path;
+    return true;
+}
+
+void FHexPathCache::Add(const FHexPathQuery& Query, const FHexPathResult& Result, const TArray<int32>& Path)
+{
+    if (!Result.bFound || Width <= 0) return;
+
+    const FHexPathCacheKey Key(Query);
+    if (Entries.Contains(Key)) return;
+
+    if (Entries.Num() >= MaxEntries)
+    {
+        EvictOldest();
+    }
+
+    FEntry& Entry = Entries.Add(Key);
+    Entry.Result = Result;
+    Entry.Path = Path;
+    Entry.LastUsed = ++UseCounter;
+
+    // ҲҪ¼Χı仯ͬı·
+    Entry.Regions.Add(GetRegionOfTile(Query.StartIndex));
+    for (int32 Tile : Path)
+    {
+        Entry.Regions.AddUnique(GetRegionOfTile(Tile));
+    }
+    Entry.Regions.Sort();
+
+    for (int32 Region : Entry.Regions)
+    {
+        RegionEntries.FindOrAdd(Region).Add(Key);
+    }
+}
+
+FHexPathResult FHexPathCache::FindPath(const FMovementCostGrid& Grid, const FHexPathQuery& Query, TArray<int32>& OutPath)
+{
+    if (Grid.Width != Width || Grid.Height != Height)
+    {
+        Reset(Grid.Width, Grid.Height);
+    }
+
+    // ƿ赲λĲѯֻڵλסʱ֣ȡռ״̬뻺
+    if (Query.AvoidIndex != INDEX_NONE)
+    {
+        return FHexPathfinder::FindPath(Grid, Query, OutPath);
+    }
+
+    FHexPathResult Result;
+    if (Find(Query, Result, OutPath)) return Result;
+
+    Result = FHexPathfinder::FindPath(Grid, Query, OutPath);
+    Add(Query, Result, OutPath);
+    return Result;
+}
+
+void FHexPathCache::InvalidateTile(int32 TileIndex)
+{
+    if (Width <= 0 || TileIndex < 0 || TileIndex >= Width * Height) return;
+
+    const int32 Region = GetRegionOfTile(TileIndex);
+
+    TArray<FHexPathCacheKey> Keys;
+    if (!RegionEntries.RemoveAndCopyValue(Region, Keys)) return;
+
+    for (const FHexPathCacheKey& Key : Keys)
+    {
+        RemoveEntry(Key, Region);
+    }
+}
+
+void FHexPathCache::RemoveEntry(const FHexPathCacheKey& Key, int32 SkipRegion)
+{
+    FEntry Entry;
+    if (!Entries.RemoveAndCopyValue(Key, Entry)) return;
+
+    Evictions++;
+
+    for (int32 Region : Entry.Regions)
+    {
+        if (Region == SkipRegion) continue;
+
+        if (TArray<FHexPathCacheKey>* Keys = RegionEntries.Find(Region))
+        {
+            Keys->RemoveSingleSwap(Key, EAllowShrinking::No);
+            if (Keys->Num() == 0)
+            {
+                RegionEntries.Remove(Region);
+            }
+        }
+    }
+}
+
+void FHexPathCache::EvictOldest()
+{
+    TArray<TPair<uint64, FHexPathCacheKey>> ByAge;
+    ByAge.Reserve(Entries.Num());
+    for (const TPair<FHexPathCacheKey, FEntry>& Pair : Entries)
+    {
+        ByAge.Emplace(Pair.Value.LastUsed, Pair.Key);
+    }
+    ByAge.Sort([](const TPair<uint64, FHexPathCacheKey>& A, const TPair<uint64, FHexPathCacheKey>& B)
+    {
+        return A.Key < B.Key;
+    });
+
+    const int32 NumToEvict = FMath::Max(1, ByAge.Num() / 4);
+    for (int32 i = 0; i < NumToEvict; i++)
+    {
+        RemoveEntry(ByAge[i].Value, INDEX_NONE);
+    }
+}
+
+void FHexPathCache::LogStats() const
+{
+    const uint64 Total = Hits + Misses;
+    UE_LOG(LogTemp, Log, TEXT("Path cache: %d entries, %llu hits, %llu misses (%.1f%% hit rate), %llu evictions"),
+        Entries.Num(), Hits, Misses, Total > 0 ? 100.0 * Hits / Total : 0.0, Evictions);
+}
@@ -0,0 +1,538 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexPathfinder.h"
+#include "HexLandmarks.h"
+#include "HexMath.h"
+#include "Landblock.h"
+#include "TerrainDataAsset.h"
+#include "HAL/ThreadSingleton.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+    struct FOpenNode
+    {
+        int32 F;
+        int32 G;
+        int32 Index;
+    };
+
+    struct FOpenNodeLess
+    {
+        FORCEINLINE bool operator()(const FOpenNode& A, const FOpenNode& B) const
+        {
+            // F ͬʱչӽĿĽڵ
+            return A.F < B.F || (A.F == B.F && A.G > B.G);
+        }
+    };
+
+    // ÿ߳һݵؿ
+    struct FHexPathSearchBuffers : public TThreadSingleton<FHexPathSearchBuffers>
+    {
+        // ʱǣ Generation ʱ BestTime/Parent Чÿβѯ
+        TArray<uint32> VisitStamp;
+        TArray<int32> BestTime;
+        TArray<int32> Parent;
+
+        //  (ڽڵڵʱ)
+        TArray<FOpenNode> OpenHeap;
+
+        // ƶΧѯͰУ±Ϊĵƶ
+        TArray<TArray<int32>> Buckets;
+
+        uint32 Generation = 0;
+
+        void Prepare(int32 NumTiles)
+        {
+            if (VisitStamp.Num() != NumTiles)
+            {
+                VisitStamp.Init(0, NumTiles);
+                BestTime.SetNumUninitialized(NumTiles);
+                Parent.SetNumUninitialized(NumTiles);
+                Generation = 0;
+            }
+
+            // ʱһα
+            if (++Generation == 0)
+            {
+                FMemory::Memzero(VisitStamp.GetData(), VisitStamp.Num() * sizeof(uint32));
+                Generation = 1;
+            }
+
+            OpenHeap.Reset();
+        }
+    };
+}
+
+uint8 FMovementCostGrid::ComputeTileCost(const ULandblock* Block, const UTerraindataasset* TerrainData)
+{
+    // ɽˮӲԹɵؿж
+    if (!Block || !Block->IsPassable()) return 0;
+
+    int32 Cost = Block->GetMovementCost();
+    if (TerrainData)
+    {
+        const FTerrainDisplayData TerrainInfo = TerrainData->GetTerrainDisplayData(Block->Terrain);
+        if (!TerrainInfo.bIsPassable) return 0;
+
+        Cost = TerrainInfo.MovementCost;
+        if (Block->Landform != ELandform::None)
+        {
+            Cost += TerrainData->GetLandformDisplayData(Block->Landform).ExtraMovementCost;
+        }
+    }
+
+    return (uint8)FMath::Clamp(Cost, 1, 255);
+}
+
+bool FMovementCostGrid::UpdateTile(int32 Index, const ULandblock* Block, const UTerraindataasset* TerrainData)
+{
+    const uint8 OldCosts[4] = { Costs[Index], EmbarkedCosts[Index], NavalCosts[Index], DeepOceanCosts[Index] };
+
+    Costs[Index] = ComputeTileCost(Block, TerrainData);
+    EmbarkedCosts[Index] = 0;
+    NavalCosts[Index] = 0;
+    DeepOceanCosts[Index] = 0;
+
+    // ˮǳԵǴɽֻͨֻԶֻͨ
+    if (Block && Block->IsWater() && Block->Landform != ELandform::Ice)
+    {
+        int32 WaterCost = 1;
+        if (TerrainData)
+        {
+            WaterCost = TerrainData->GetTerrainDisplayData(Block->Terrain).MovementCost;
+        }
+        const uint8 Cost = (uint8)FMath::Clamp(WaterCost, 1, 255);
+
+        if (Block->Terrain == ETerrain::Coast)
+        {
+            EmbarkedCosts[Index] = Cost;
+            NavalCosts[Index] = Cost;
+        }
+        else
+        {
+            DeepOceanCosts[Index] = Cost;
+        }
+    }
+
+    const uint8 NewCosts[4] = { Costs[Index], EmbarkedCosts[Index], NavalCosts[Index], DeepOceanCosts[Index] };
+    for (int32 Layer = 0; Layer < 4; Layer++)
+    {
+        if ((OldCosts[Layer] == 0) != (NewCosts[Layer] == 0)) return true;
+    }
+    return false;
+}
+
+void FMovementCostGrid::EnsureZoneOfControlPlayers(int32 NumPlayers)
+{
+    const int32 OldNum = ZoneOfControl.Num();
+    if (NumPlayers <= OldNum) return;
+
+    if (ZoneOfControlTotal.Num() != Num())
+    {
+        ZoneOfControlTotal.SetNumZeroed(Num());
+    }
+
+    ZoneOfControl.SetNum(NumPlayers);
+    ZoneOfControlCounts.SetNum(NumPlayers);
+    for (int32 Player = OldNum; Player < NumPlayers; Player++)
+    {
+        ZoneOfControlCounts[Player].SetNumZeroed(Num());
+
+        // ûеλܵеλĿӰ
+        TBitArray<>& Bits = ZoneOfControl[Player];
+        Bits.Init(false, Num());
+        for (int32 Index = 0; Index < Num(); Index++)
+        {
+            if (ZoneOfControlTotal[Index] > 0) Bits[Index] = true;
+        }
+    }
+}
+
+void FMovementCostGrid::UpdateZoneOfControl(int32 OwnerPlayer, int32 TileIndex, int32 Delta)
+{
+    if (OwnerPlayer < 0 || !Costs.IsValidIndex(TileIndex)) return;
+
+    EnsureZoneOfControlPlayers(OwnerPlayer + 1);
+
+    const int32 NumPlayers = ZoneOfControl.Num();
+    const int32 X = TileIndex % Width;
+    const int32 Y = TileIndex / Width;
+
+    // ڵؿ 6 ھ
+    for (int32 Dir = -1; Dir < 6; Dir++)
+    {
+        const int32 Tile = Dir < 0 ? TileIndex : FHexMath::GetNeighborIndex(X, Y, Dir, Width, Height);
+        if (Tile == INDEX_NONE) continue;
+
+        uint8& Count = ZoneOfControlCounts[OwnerPlayer][Tile];
+        const int32 OldCount = Count;
+        Count = (uint8)FMath::Clamp(OldCount + Delta, 0, MAX_uint8);
+
+        uint16& Total = ZoneOfControlTotal[Tile];
+        Total = (uint16)(Total + Count - OldCount);
+
+        // ǴΪ (򱣳Ϊ 0) ʱҵ Total - Counts[P]  0
+        if ((OldCount > 0) == (Count > 0)) continue;
+
+        for (int32 Player = 0; Player < NumPlayers; Player++)
+        {
+            if (Player == OwnerPlayer) continue;
+            ZoneOfControl[Player][Tile] = Total - ZoneOfControlCounts[Player][Tile] > 0;
+        }
+    }
+}
+
+void FMovementCostGrid::InitEmpty(int32 InWidth, int32 InHeight)
+{
+    Width = InWidth;
+    Height = InHeight;
+
+    const int32 NumTiles = Width * Height;
+    Costs.SetNumZeroed(NumTiles);
+    EmbarkedCosts.SetNumZeroed(NumTiles);
+    NavalCosts.SetNumZeroed(NumTiles);
+    DeepOceanCosts.SetNumZeroed(NumTiles);
+    Occupied.Init(false, NumTiles);
+    ZoneOfControl.Reset();
+    ZoneOfControlCounts.Reset();
+    ZoneOfControlTotal.Reset();
+}
+
+void FMovementCostGrid::Build(const TArray<ULandblock*>& MapGrid, int32 InWidth, int32 InHeight, const UTerraindataasset* TerrainData)
+{
+    InitEmpty(InWidth, InHeight);
+    EmbarkCost = (uint8)FMath::Clamp(TerrainData ? TerrainData->EmbarkMovementCost : 1, 0, 255);
+
+    for (int32 Index = 0; Index < Costs.Num(); Index++)
+    {
+        const ULandblock* Block = MapGrid.IsValidIndex(Index) ? MapGrid[Index] : nullptr;
+        UpdateTile(Index, Block, TerrainData);
+        Occupied[Index] = Block && Block->HasUnit();
+    }
+
+    BuildComponents();
+}
+
+void FMovementCostGrid::BuildComponents()
+{
+    TArray<int32> Stack;
+
+    for (int32 ClassIndex = 0; ClassIndex < NumMovementClasses; ClassIndex++)
+    {
+        const EMovementClass Class = (EMovementClass)ClassIndex;
+        TArray<int32>& Labels = Components[ClassIndex];
+        Labels.Init(INDEX_NONE, Num());
+
+        // ˮ䣬ÿδǵĿͨеؿ鿪ʼһ·
+        int32 NextLabel = 0;
+        for (int32 Seed = 0; Seed < Num(); Seed++)
+        {
+            if (Labels[Seed] != INDEX_NONE || GetCost(Class, Seed) == 0) continue;
+
+            Labels[Seed] = NextLabel;
+            Stack.Reset();
+            Stack.Add(Seed);
+
+            while (Stack.Num() > 0)
+            {
+                const int32 Current = Stack.Pop(EAllowShrinking::No);
+                const int32 X = Current % Width;
+                const int32 Y = Current / Width;
+
+                for (int32 Dir = 0; Dir < 6; Dir++)
+                {
+                    const int32 Next = FHexMath::GetNeighborIndex(X, Y, Dir, Width, Height);
+                    if (Next == INDEX_NONE || Labels[Next] != INDEX_NONE || GetCost(Class, Next) == 0) continue;
+
+                    Labels[Next] = NextLabel;
+                    Stack.Add(Next);
+                }
+            }
+
+            NextLabel++;
+        }
+    }
+}
+
+int32 FHexReachableSet::FindSlot(int32 TileIndex) const
+{
+    for (int32 Slot = 0; Slot < Tiles.Num(); Slot++)
+    {
+        if (Tiles[Slot].Index == TileIndex) return Slot;
+    }
+    return INDEX_NONE;
+}
+
+bool FHexReachableSet::BuildPathTo(int32 TileIndex, TArray<int32>& OutPath) const
+{
+    OutPath.Reset();
+    if (TileIndex == OriginIndex || !Contains(TileIndex)) return false;
+
+    for (int32 Index = TileIndex; Index != OriginIndex; )
+    {
+        OutPath.Add(Index);
+        Index = Tiles[FindSlot(Index)].Predecessor;
+    }
+    return true;
+}
+
+FHexPathResult FHexPathfinder::FindPath(const FMovementCostGrid& Grid, const FHexPathQuery& Query, TArray<int32>& OutPath)
+{
+    FHexPathResult Result;
+    OutPath.Reset();
+
+    if (!Grid.IsValid() || !Grid.Costs.IsValidIndex(Query.StartIndex) || !Grid.Costs.IsValidIndex(Query.GoalIndex)) return Result;
+    if (Query.StartIndex == Query.GoalIndex) return Result;
+
+    // ͬһͨ (Ĵ½)
+    const EMovementClass Class = Query.MovementClass;
+    if (!Grid.AreConnected(Class, Query.StartIndex, Query.GoalIndex)) return Result;
+
+    const TBitArray<>* ZoneOfControl = Grid.ZoneOfControl.IsValidIndex(Query.ZoneOfControlPlayer) ? &Grid.ZoneOfControl[Query.ZoneOfControlPlayer] : nullptr;
+
+    const int32 Width = Grid.Width;
+    const int32 Height = Grid.Height;
+    const int32 MaxMP = FMath::Max(1, Query.MaxMovementPoints);
+    const int32 StartMP = FMath::Clamp(Query.StartMovementPoints, 0, MaxMP);
+    const int32 GoalX = Query.GoalIndex % Width;
+    const int32 GoalY = Query.GoalIndex / Width;
+
+    FHexPathSearchBuffers& Buffers = FHexPathSearchBuffers::Get();
+    Buffers.Prepare(Grid.Num());
+
+    const uint32 Generation = Buffers.Generation;
+    uint32* VisitStamp = Buffers.VisitStamp.GetData();
+    int32* BestTime = Buffers.BestTime.GetData();
+    int32* Parent = Buffers.Parent.GetData();
+    TArray<FOpenNode>& OpenHeap = Buffers.OpenHeap;
+
+    // ÿΪ 1ξ벻߹ر½簴ضļ㣬ͬ߹
+    const FHexLandmarkTable* Landmarks = Query.bUseLandmarks && Grid.Landmarks.IsValid() && Grid.Landmarks->CanUse(Class, MaxMP)
+        ? Grid.Landmarks.Get() : nullptr;
+    const int32 GoalIndex = Query.GoalIndex;
+    auto Heuristic = [&Grid, Landmarks, Class, Width, GoalX, GoalY, GoalIndex](int32 Index)
+    {
+        const int32 Distance = FHexMath::Distance(Index % Width, Index / Width, GoalX, GoalY, Width);
+        return Landmarks ? FMath::Max(Distance, Landmarks->GetLowerBound(Class, Grid, Index, GoalIndex)) : Distance;
+    };
+
+    // ʱ = غ * MaxMP + غƶ
+    const int32 StartTime = MaxMP - StartMP;
+    VisitStamp[Query.StartIndex] = Generation;
+    BestTime[Query.StartIndex] = StartTime;
+    Parent[Query.StartIndex] = INDEX_NONE;
+    OpenHeap.HeapPush({ StartTime + Heuristic(Query.StartIndex), StartTime, Query.StartIndex }, FOpenNodeLess());
+
+    FOpenNode Current;
+    while (OpenHeap.Num() > 0)
+    {
+        OpenHeap.HeapPop(Current, FOpenNodeLess(), EAllowShrinking::No);
+
+        // ڽڵ㣺֮ҵ˸ĵʱ
+        if (Current.G != BestTime[Current.Index]) continue;
+
+        Result.NodesExpanded++;
+
+        if (Current.Index == Query.GoalIndex)
+        {
+            Result.bFound = true;
+            Result.ArrivalTime = Current.G;
+            Result.Turns = (Current.G - 1) / MaxMP + 1;
+
+            for (int32 Index = Current.Index; Index != Query.StartIndex; Index = Parent[Index])
+            {
+                OutPath.Add(Index);
+            }
+            return Result;
+        }
+
+        const int32 X = Current.Index % Width;
+        const int32 Y = Current.Index / Width;
+        const int32 Remaining = MaxMP - Current.G % MaxMP;
+
+        for (int32 Dir = 0; Dir < 6; Dir++)
+        {
+            const int32 Next = FHexMath::GetNeighborIndex(X, Y, Dir, Width, Height);
+            if (Next == INDEX_NONE || Grid.GetCost(Class, Next) == 0) continue;
+            if (Next == Query.AvoidIndex && Next != Query.GoalIndex) continue;
+
+            const int32 StepCost = ClampStepCost(Grid.GetStepCost(Class, Current.Index, Next), MaxMP);
+
+            // ʣƶʱȵ»غٽ
+            int32 NextTime = StepCost <= Remaining
+                ? Current.G + StepCost
+                : (Current.G / MaxMP + 1) * MaxMP + StepCost;
+
+            // зغϵƶľ
+            if (ZoneOfControl && Next != Query.GoalIndex && (*ZoneOfControl)[Next])
+            {
+                NextTime = FMath::DivideAndRoundUp(NextTime, MaxMP) * MaxMP;
+            }
+
+            if (VisitStamp[Next] == Generation && NextTime >= BestTime[Next]) continue;
+
+            VisitStamp[Next] = Generation;
+            BestTime[Next] = NextTime;
+            Parent[Next] = Current.Index;
+            OpenHeap.HeapPush({ NextTime + Heuristic(Next), NextTime, Next }, FOpenNodeLess());
+        }
+    }
+
+    return Result;
+}
+
+void FHexPathfinder::FindReachable(const FMovementCostGrid& Grid, int32 OriginIndex, int32 MovementPoints, int32 MaxMovementPoints, FHexReachableSet& OutReachable,
+    EMovementClass MovementClass, int32 ZoneOfControlPlayer)
+{
+    OutReachable.Reset();
+    OutReachable.OriginIndex = OriginIndex;
+    OutReachable.MovementPoints = MovementPoints;
+
+    if (!Grid.IsValid() || !Grid.Costs.IsValidIndex(OriginIndex) || MovementPoints < 0) return;
+
+    const int32 Width = Grid.Width;
+    const int32 Height = Grid.Height;
+    const int32 MaxMP = FMath::Max(1, MaxMovementPoints);
+
+    FHexPathSearchBuffers& Buffers = FHexPathSearchBuffers::Get();
+    Buffers.Prepare(Grid.Num());
+
+    const uint32 Generation = Buffers.Generation;
+    uint32* VisitStamp = Buffers.VisitStamp.GetData();
+    int32* BestSpent = Buffers.BestTime.GetData();
+    int32* Parent = Buffers.Parent.GetData();
+
+    const TBitArray<>* ZoneOfControl = Grid.ZoneOfControl.IsValidIndex(ZoneOfControlPlayer) ? &Grid.ZoneOfControl[ZoneOfControlPlayer] : nullptr;
+
+    TArray<TArray<int32>>& Buckets = Buffers.Buckets;
+    if (Buckets.Num() < MovementPoints + 1)
+    {
+        Buckets.SetNum(MovementPoints + 1);
+    }
+    for (int32 Spent = 0; Spent <= MovementPoints; Spent++)
+    {
+        Buckets[Spent].Reset();
+    }
+
+    VisitStamp[OriginIndex] = Generation;
+    BestSpent[OriginIndex] = 0;
+    Parent[OriginIndex] = INDEX_NONE;
+    Buckets[0].Add(OriginIndex);
+
+    // ÿΪ 1ֻͰǰͰʱ
+    for (int32 Spent = 0; Spent <= MovementPoints; Spent++)
+    {
+        for (int32 Current : Buckets[Spent])
+        {
+            // Ŀ֮ҵ˸С
+            if (BestSpent[Current] != Spent) continue;
+
+            OutReachable.Tiles.Add({ Current, MovementPoints - Spent, Parent[Current] });
+
+            const int32 X = Current % Width;
+            const int32 Y = Current / Width;
+            for (int32 Dir = 0; Dir < 6; Dir++)
+            {
+                const int32 Next = FHexMath::GetNeighborIndex(X, Y, Dir, Width, Height);
+                if (Next == INDEX_NONE || Grid.GetCost(MovementClass, Next) == 0 || Grid.IsOccupied(Next)) continue;
+
+                int32 NextSpent = Spent + ClampStepCost(Grid.GetStepCost(MovementClass, Current, Next), MaxMP);
+                if (NextSpent > MovementPoints) continue;
+
+                // зܼƶ
+                if (ZoneOfControl && (*ZoneOfControl)[Next])
+                {
+                    NextSpent = MovementPoints;
+                }
+                if (VisitStamp[Next] == Generation && NextSpent >= BestSpent[Next]) continue;
+
+                VisitStamp[Next] = Generation;
+                BestSpent[Next] = NextSpent;
+                Parent[Next] = Current;
+                Buckets[NextSpent].Add(Next);
+            }
+        }
+    }
+}
+
+void FHexPathfinder::MakeRandomGrid(int32 Width, int32 Height, int32 Seed, FMovementCostGrid& OutGrid)
+{
+    FRandomStream Random(Seed);
+
+    // Լ 15% ͨУ 1~3
+    OutGrid.InitEmpty(Width, Height);
+    for (uint8& Cost : OutGrid.Costs)
+    {
+        Cost = Random.FRand() < 0.15f ? 0 : (uint8)Random.RandRange(1, 3);
+    }
+    OutGrid.BuildComponents();
+}
+
+void FHexPathfinder::RunBenchmark(int32 Width, int32 Height, int32 NumQueries, int32 Seed)
+{
+    FMovementCostGrid Grid;
+    MakeRandomGrid(Width, Height, Seed, Grid);
+
+    RunBenchmarkOnGrid(Grid, NumQueries, Seed, TEXT("Random"));
+}
+
+void FHexPathfinder::RunBenchmarkOnGrid(const FMovementCostGrid& Grid, int32 NumQueries, int32 Seed, const TCHAR* Label)
+{
+    if (!Grid.IsValid() || NumQueries <= 0) return;
+
+    FRandomStream Random(Seed);
+
+    // ԤɲѯʱֻѰ·
+    auto RandomPassableTile = [&Grid, &Random]()
+    {
+        for (int32 Attempt = 0; Attempt < 64; Attempt++)
+        {
+            const int32 Index = Random.RandRange(0, Grid.Num() - 1);
+            if (Grid.Costs[Index] != 0) return Index;
+        }
+        return (int32)INDEX_NONE;
+    };
+
+    TArray<FHexPathQuery> Queries;
+    Queries.Reserve(NumQueries);
+    for (int32 i = 0; i < NumQueries; i++)
+    {
+        FHexPathQuery Query;
+        Query.StartIndex = RandomPassableTile();
+        Query.GoalIndex = RandomPassableTile();
+        if (Query.StartIndex == INDEX_NONE || Query.GoalIndex == INDEX_NONE) continue;
+
+        Query.MaxMovementPoints = 2;
+        Query.StartMovementPoints = 2;
+        Queries.Add(Query);
+    }
+    if (Queries.Num() == 0) return;
+
+    TArray<int32> Path;
+    Path.Reserve(Grid.Num());
+
+    // Ԥȣ䱾̵߳
+    FindPath(Grid, Queries[0], Path);
+
+    int64 TotalNodes = 0;
+    int64 TotalLength = 0;
+    int32 NumFound = 0;
+
+    const double StartTime = FPlatformTime::Seconds();
+    for (const FHexPathQuery& Query : Queries)
+    {
+        const FHexPathResult Result = FindPath(Grid, Query, Path);
+        TotalNodes += Result.NodesExpanded;
+        if (Result.bFound)
+        {
+            NumFound++;
+            TotalLength += Path.Num();
+        }
+    }
+    const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    UE_LOG(LogTemp, Log, TEXT("Pathfinding benchmark [%s] %dx%d: %d queries in %.2f ms (%.1f us/query), found %d, avg nodes %.0f, avg length %.1f"),
+        Label, Grid.Width, Grid.Height, Queries.Num(), ElapsedMs, ElapsedMs * 1000.0 / Queries.Num(), NumFound,
+        (double)TotalNodes / Queries.Num(), NumFound > 0 ? (double)TotalLength / NumFound : 0.0);
+}
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexTileMemory.h"
+#include "HexVisibility.h"
+#include "Landblock.h"
+#include "Building.h"
+#include "City.h"
+
+FHexTileSnapshot FHexTileSnapshot::Capture(const ULandblock* Block)
+{
+    FHexTileSnapshot Snapshot;
+    if (!Block) return Snapshot;
+
+    if (Block->Building)
+    {
+        Snapshot.Building = Block->Building->Type;
+    }
+
+    if (const ACity* City = Block->OwningCity)
+    {
+        Snapshot.OwnerPlayer = static_cast<int8>(City->PlayerOwnerIndex);
+        Snapshot.bHasCity = City->GridX == Block->X && City->GridY == Block->Y;
+    }
+
+    return Snapshot;
+}
+
+void FHexTileMemory::Init(int32 NumPlayers)
+{
+    PlayerMemory.Reset();
+    PlayerMemory.SetNum(FMath::Max(NumPlayers, 0));
+}
+
+void FHexTileMemory::RecordBeforeChange(int32 TileIndex, const FHexTileSnapshot& Current, const FHexVisibility& Visibility)
+{
+    for (int32 Player = 0; Player < PlayerMemory.Num(); Player++)
+    {
+        if (Visibility.GetState(Player, TileIndex) != EVisibilityState::FogOfWar) continue;
+
+        // мʱĿ (һο)
+        TMap<int32, FHexTileSnapshot>& Memory = PlayerMemory[Player];
+        if (!Memory.Contains(TileIndex))
+        {
+            Memory.Add(TileIndex, Current);
+        }
+    }
+}
+
+bool FHexTileMemory::Forget(int32 Player, int32 TileIndex)
+{
+    return PlayerMemory.IsValidIndex(Player) && PlayerMemory[Player].Remove(TileIndex) > 0;
+}
+
+void FHexTileMemory::ForgetVisible(int32 Player, const FHexVisibility& Visibility, TArray<int32>& OutForgotten)
+{
+    if (!PlayerMemory.IsValidIndex(Player)) return;
+
+    for (auto It = PlayerMemory[Player].CreateIterator(); It; ++It)
+    {
+        if (Visibility.IsVisible(Player, It.Key()))
+        {
+            OutForgotten.Add(It.Key());
+            It.RemoveCurrent();
+        }
+    }
+}
+
+FHexTileSnapshot FHexTileMemory::GetSeen(int32 Player, int32 TileIndex, const ULandblock* Block, const FHexVisibility& Visibility) const
+{
+    // δ̽ĵؿûκϢ
+    if (Visibility.GetState(Player, TileIndex) == EVisibilityState::Unexplored)
+    {
+        return FHexTileSnapshot();
+    }
+
+    if (const FHexTileSnapshot* Remembered = Find(Player, TileIndex))
+    {
+        return *Remembered;
+    }
+    return FHexTileSnapshot::Capture(Block);
+}
+
+void FHexTileMemory::GetRememberedTiles(int32 PlayerA, int32 PlayerB, TArray<int32>& OutTiles) const
+{
+    if (PlayerMemory.IsValidIndex(PlayerA))
+    {
+        PlayerMemory[PlayerA].GetKeys(OutTiles);
+    }
+
+    if (PlayerMemory.IsValidIndex(PlayerB) && PlayerB != PlayerA)
+    {
+        const TMap<int32, FHexTileSnapshot>* MemoryA = PlayerMemory.IsValidIndex(PlayerA) ? &PlayerMemory[PlayerA] : nullptr;
+        for (const TPair<int32, FHexTileSnapshot>& Pair : PlayerMemory[PlayerB])
+        {
+            if (!MemoryA || !MemoryA->Contains(Pair.Key))
+            {
+                OutTiles.Add(Pair.Key);
+            }
+        }
+    }
+}
+
+SIZE_T FHexTileMemory::GetAllocatedSize() const
+{
+    SIZE_T Size = PlayerMemory.GetAllocatedSize();
+    for (const TMap<int32, FHexTileSnapshot>& Memory : PlayerMemory)
+    {
+        Size += Memory.GetAllocatedSize();
+    }
+    return Size;
+}
@@ -0,0 +1,239 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexVisibility.h"
+#include "Landblock.h"
+
+FHexSightRays::FHexSightRays()
+{
+    constexpr int32 R = MaxSightRadius;
+    constexpr int32 Span = 2 * R + 1;
+
+    //  ->  (λżеԭ㣬ƫԭغ)
+    int32 SlotOfAxial[Span * Span];
+    for (int32 i = 0; i < Span * Span; i++) SlotOfAxial[i] = INDEX_NONE;
+
+    FIntPoint Axial[NumTargets];
+    for (int32 Slot = 0; Slot < NumTargets; Slot++)
+    {
+        Axial[Slot] = FHexMath::OffsetToAxial(FHexMath::SpiralOffsets.DX[Slot], FHexMath::SpiralOffsets.DY[0][Slot]);
+        SlotOfAxial[(Axial[Slot].Y + R) * Span + Axial[Slot].X + R] = Slot;
+    }
+
+    // ƫƣ߶ǡؿ齻ʱȡȷ
+    constexpr double Nudge[2][3] = { { 1e-6, 2e-6, -3e-6 }, { -1e-6, -2e-6, 3e-6 } };
+
+    TArray<uint8, TInlineAllocator<MaxSightRadius>> RaySteps[2];
+    for (int32 Target = 1; Target < NumTargets; Target++)
+    {
+        const FIntVector Cube = FHexMath::AxialToCube(Axial[Target]);
+        const int32 Distance = FHexMath::CubeDistance(FIntVector::ZeroValue, Cube);
+
+        for (int32 Side = 0; Side < 2; Side++)
+        {
+            RaySteps[Side].Reset();
+            for (int32 Step = 1; Step < Distance; Step++)
+            {
+                const double T = (double)Step / Distance;
+                const FIntVector Rounded = FHexMath::CubeRound(Cube.X * T + Nudge[Side][0], Cube.Y * T + Nudge[Side][1], Cube.Z * T + Nudge[Side][2]);
+                const FIntPoint StepAxial = FHexMath::CubeToAxial(Rounded);
+                RaySteps[Side].Add((uint8)SlotOfAxial[(StepAxial.Y + R) * Span + StepAxial.X + R]);
+            }
+        }
+
+        // ͬʱֻһ
+        NumRays[Target] = RaySteps[0] == RaySteps[1] ? 1 : 2;
+        for (int32 Side = 0; Side < NumRays[Target]; Side++)
+        {
+            Rays[Target][Side].Start = (uint16)Steps.Num();
+            Rays[Target][Side].Count = (uint8)RaySteps[Side].Num();
+            Steps.Append(RaySteps[Side]);
+        }
+    }
+}
+
+const FHexSightRays& FHexSightRays::Get()
+{
+    static const FHexSightRays Instance;
+    return Instance;
+}
+
+void FHexVisibility::Init(int32 InWidth, int32 InHeight, int32 NumPlayers)
+{
+    Width = InWidth;
+    Height = InHeight;
+
+    const int32 NumTiles = Width * Height;
+    Blockers[0].Init(false, NumTiles);
+    Blockers[1].Init(false, NumTiles);
+    Elevated.Init(false, NumTiles);
+
+    Players.SetNum(NumPlayers);
+    for (FPlayerPlanes& Planes : Players)
+    {
+        Planes.Visible.Init(false, NumTiles);
+        Planes.Explored.Init(false, NumTiles);
+        Planes.ObserverCounts.SetNumZeroed(NumTiles);
+    }
+}
+
+void FHexVisibility::BuildBlockers(const TArray<ULandblock*>& MapGrid)
+{
+    for (int32 Index = 0; Index < MapGrid.Num() && Index < Elevated.Num(); Index++)
+    {
+        UpdateBlocker(Index, MapGrid[Index]);
+    }
+}
+
+void FHexVisibility::UpdateBlocker(int32 Index, const ULandblock* Block)
+{
+    if (!Elevated.IsValidIndex(Index)) return;
+
+    const ELandform Landform = Block ? Block->Landform : ELandform::None;
+    const bool bMountain = Landform == ELandform::Mountain;
+    const bool bLowBlocker = Landform == ELandform::Hills || Landform == ELandform::Forest || Landform == ELandform::Rainforest;
+
+    Blockers[0][Index] = bMountain || bLowBlocker;
+    Blockers[1][Index] = bMountain;
+    Elevated[Index] = Landform == ELandform::Hills;
+}
+
+void FHexVisibility::ComputeSight(int32 X, int32 Y, int32 Radius, FHexSightMask& OutMask) const
+{
+    OutMask.Reset();
+    if (!IsValid() || X < 0 || X >= Width || Y < 0 || Y >= Height) return;
+
+    const FHexSightRays& Table = FHexSightRays::Get();
+    const int8* DX = FHexMath::SpiralOffsets.DX;
+    const int8* DY = FHexMath::SpiralOffsets.DY[X & 1];
+
+    const TBitArray<>& Blocking = Blockers[Elevated[Y * Width + X] ? 1 : 0];
+
+    // ƫߵмؿܱ˶ƫһУͼĵؿ鲻ڵ
+    auto IsBlocked = [&](int32 Slot)
+    {
+        const int32 NY = Y + DY[Slot];
+        return NY >= 0 && NY < Height && Blocking[NY * Width + FHexMath::WrapX(X + DX[Slot], Width)];
+    };
+
+    OutMask.Set(0);
+
+    const int32 NumSlots = FHexMath::NumTilesInRadius(FMath::Clamp(Radius, 0, FHexSightRays::MaxSightRadius));
+    for (int32 Target = 1; Target < NumSlots; Target++)
+    {
+        const int32 TargetY = Y + DY[Target];
+        if (TargetY < 0 || TargetY >= Height) continue;
+
+        for (int32 RayIndex = 0; RayIndex < Table.NumRays[Target]; RayIndex++)
+        {
+            const FHexSightRays::FRay& Ray = Table.Rays[Target][RayIndex];
+            const uint8* Step = Table.Steps.GetData() + Ray.Start;
+
+            bool bClear = true;
+            for (int32 i = 0; i < Ray.Count && bClear; i++)
+            {
+                bClear = !IsBlocked(Step[i]);
+            }
+
+            if (bClear)
+            {
+                OutMask.Set(Target);
+                break;
+            }
+        }
+    }
+}
+
+void FHexVisibility::ResetPlayer(int32 Player)
+{
+    if (!Players.IsValidIndex(Player)) return;
+
+    FPlayerPlanes& Planes = Players[Player];
+    Planes.Visible.SetRange(0, Planes.Visible.Num(), false);
+    FMemory::Memzero(Planes.ObserverCounts.GetData(), Planes.ObserverCounts.Num());
+}
+
+void FHexVisibility::AddSight(int32 Player, int32 X, int32 Y, const FHexSightMask& Mask, TArray<int32>& OutChanged)
+{
+    if (!Players.IsValidIndex(Player)) return;
+
+    FPlayerPlanes& Planes = Players[Player];
+    ForEachVisibleTile(X, Y, Mask, [&](int32 Index)
+    {
+        IncrementObserver(Planes, Index, OutChanged);
+    });
+}
+
+void FHexVisibility::RemoveSight(int32 Player, int32 X, int32 Y, const FHexSightMask& Mask, TArray<int32>& OutChanged)
+{
+    if (!Players.IsValidIndex(Player)) return;
+
+    FPlayerPlanes& Planes = Players[Player];
+    ForEachVisibleTile(X, Y, Mask, [&](int32 Index)
+    {
+        DecrementObserver(Planes, Index, OutChanged);
+    });
+}
+
+void FHexVisibility::MoveSight(int32 Player, int32 OldX, int32 OldY, const FHexSightMask& OldMask,
+    int32 NewX, int32 NewY, const FHexSightMask& NewMask, TArray<int32>& OutChanged)
+{
+    if (!Players.IsValidIndex(Player)) return;
+
+    // Ұĵؿ鲢ͬĵؿ䣬Ҫ
+    TArray<int32, TInlineAllocator<FHexSightRays::NumTargets>> OldTiles;
+    TArray<int32, TInlineAllocator<FHexSightRays::NumTargets>> NewTiles;
+    ForEachVisibleTile(OldX, OldY, OldMask, [&OldTiles](int32 Index) { OldTiles.Add(Index); });
+    ForEachVisibleTile(NewX, NewY, NewMask, [&NewTiles](int32 Index) { NewTiles.Add(Index); });
+    OldTiles.Sort();
+    NewTiles.Sort();
+
+    FPlayerPlanes& Planes = Players[Player];
+    int32 i = 0;
+    int32 j = 0;
+    while (i < OldTiles.Num() && j < NewTiles.Num())
+    {
+        if (OldTiles[i] < NewTiles[j])
+        {
+            DecrementObserver(Planes, OldTiles[i++], OutChanged);
+        }
+        else if (NewTiles[j] < OldTiles[i])
+        {
+            IncrementObserver(Planes, NewTiles[j++], OutChanged);
+        }
+        else
+        {
+            i++;
+            j++;
+        }
+    }
+    for (; i < OldTiles.Num(); i++) DecrementObserver(Planes, OldTiles[i], OutChanged);
+    for (; j < NewTiles.Num(); j++) IncrementObserver(Planes, NewTiles[j], OutChanged);
+}
+
+void FHexVisibility::GetDifferingTiles(int32 PlayerA, int32 PlayerB, TArray<int32>& OutTiles) const
+{
+    OutTiles.Reset();
+    if (!Players.IsValidIndex(PlayerA) || !Players.IsValidIndex(PlayerB)) return;
+
+    const FPlayerPlanes& A = Players[PlayerA];
+    const FPlayerPlanes& B = Players[PlayerB];
+
+    const int32 NumTiles = A.Visible.Num();
+    const int32 NumWords = FMath::DivideAndRoundUp(NumTiles, (int32)NumBitsPerDWORD);
+    const uint32* VisibleA = A.Visible.GetData();
+    const uint32* VisibleB = B.Visible.GetData();
+    const uint32* ExploredA = A.Explored.GetData();
+    const uint32* ExploredB = B.Explored.GetData();
+
+    for (int32 Word = 0; Word < NumWords; Word++)
+    {
+        for (uint32 Bits = (VisibleA[Word] ^ VisibleB[Word]) | (ExploredA[Word] ^ ExploredB[Word]); Bits != 0; Bits &= Bits - 1)
+        {
+            const int32 Index = Word * NumBitsPerDWORD + (int32)FMath::CountTrailingZeros(Bits);
+            if (Index < NumTiles)
+            {
+                OutTiles.Add(Index);
+            }
+        }
+    }
+}
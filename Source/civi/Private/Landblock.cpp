@@ -11,6 +11,7 @@ ULandblock::ULandblock()
     Y = 0;
     Terrain = ETerrain::Plain;
     Landform = ELandform::None;
+    Resource = EResourceType::None;
     Building = nullptr;
 }
 
@@ -58,8 +59,8 @@ bool ULandblock::IsPassable() const
         return false;
     }
 
-    // Ĭϲͨ (к)
-    if (Terrain == ETerrain::Ocean)
+    // ˮҪǴֻ
+    if (IsWater())
     {
         return false;
     }
@@ -117,21 +118,65 @@ int32 ULandblock::GetMovementCost() const
 
 void ULandblock::ConstructBuilding(EBuildingType NewBuildingType)
 {
+    // еҼסɽ
+    ACivi_GameModeBase* GM = GetTypedOuter<ACivi_GameModeBase>();
+    if (GM)
+    {
+        GM->NotifyTileStateChanging(this);
+    }
+
     if (NewBuildingType == EBuildingType::None)
     {
         Building = nullptr;
-        return;
+    }
+    else
+    {
+        // µĽ߼
+        Building = NewObject<UBuilding>(this);
+        Building->Type = NewBuildingType;
+    }
+
+    // ֻ¸õؿȾʵ
+    if (GM)
+    {
+        GM->RefreshTileVisuals(this);
+    }
+}
+
+void ULandblock::SetOccupyingUnit(AUnit* NewUnit)
+{
+    if (OccupyingUnit == NewUnit) return;
+
+    OccupyingUnit = NewUnit;
+
+    // ؿϷģʽ֪ͨռϢ
+    if (ACivi_GameModeBase* GM = GetTypedOuter<ACivi_GameModeBase>())
+    {
+        GM->OnTileOccupancyChanged(this);
+    }
+}
+
+void ULandblock::SetOwningCity(ACity* NewCity)
+{
+    if (OwningCity == NewCity) return;
+
+    if (ACivi_GameModeBase* GM = GetTypedOuter<ACivi_GameModeBase>())
+    {
+        GM->NotifyTileStateChanging(this);
     }
 
-    // µĽ߼
-    Building = NewObject<UBuilding>(this);
-    Building->Type = NewBuildingType;
+    OwningCity = NewCity;
 }
 
 void ULandblock::SetWonder(EWonderType NewWonderType)
 {
     WonderType = NewWonderType;
     // ߼ģȫΨһԵ
+
+    if (ACivi_GameModeBase* GM = GetTypedOuter<ACivi_GameModeBase>())
+    {
+        GM->RefreshTileVisuals(this);
+    }
 }
 
 FYields ULandblock::GetTotalYield(const UTerraindataasset* TData, const UBuildingDataAsset* BData) const
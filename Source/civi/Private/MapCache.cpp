@@ -0,0 +1,139 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MapCache.h"
+#include "Landblock.h"
+#include "Async/MappedFileHandle.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+uint64 FMapCacheKey::ComputeHash() const
+{
+    // ̶˳дв (λȽ)
+    TArray<uint8> Bytes;
+    auto Append = [&Bytes](const void* Data, int32 Size)
+    {
+        Bytes.Append(static_cast<const uint8*>(Data), Size);
+    };
+
+    const uint32 Version = FMapCache::GeneratorVersion;
+    Append(&Version, sizeof(Version));
+    Append(&Seed, sizeof(Seed));
+    Append(&Width, sizeof(Width));
+    Append(&Height, sizeof(Height));
+    Append(&ElevationScale, sizeof(ElevationScale));
+    Append(&MoistureScale, sizeof(MoistureScale));
+    Append(&TemperatureScale, sizeof(TemperatureScale));
+    Append(&Octaves, sizeof(Octaves));
+    Append(&Persistence, sizeof(Persistence));
+    Append(&Lacunarity, sizeof(Lacunarity));
+
+    const uint8 FixedPoint = bFixedPointNoise ? 1 : 0;
+    Append(&FixedPoint, sizeof(FixedPoint));
+    Append(&ResourceRulesHash, sizeof(ResourceRulesHash));
+
+    return CityHash64(reinterpret_cast<const char*>(Bytes.GetData()), Bytes.Num());
+}
+
+FString FMapCache::GetCacheFilePath(const FMapCacheKey& Key)
+{
+    return FPaths::ProjectSavedDir() / TEXT("MapCache") / FString::Printf(TEXT("%016llx.civimap"), Key.ComputeHash());
+}
+
+bool FMapCache::Save(const FMapCacheKey& Key, const TArray<ULandblock*>& MapGrid)
+{
+    const int32 NumTiles = Key.Width * Key.Height;
+    if (NumTiles <= 0 || MapGrid.Num() != NumTiles) return false;
+
+    TArray<uint8> Buffer;
+    Buffer.SetNumZeroed(sizeof(FHeader) + NumTiles * sizeof(FMapCacheTile));
+
+    FMapCacheTile* Tiles = reinterpret_cast<FMapCacheTile*>(Buffer.GetData() + sizeof(FHeader));
+    for (int32 i = 0; i < NumTiles; i++)
+    {
+        const ULandblock* Block = MapGrid[i];
+        if (!Block) return false;
+
+        Tiles[i].Terrain = static_cast<uint8>(Block->Terrain);
+        Tiles[i].Landform = static_cast<uint8>(Block->Landform);
+        Tiles[i].Wonder = static_cast<uint8>(Block->WonderType);
+        Tiles[i].Resource = static_cast<uint8>(Block->Resource);
+    }
+
+    FHeader* Header = reinterpret_cast<FHeader*>(Buffer.GetData());
+    Header->Magic = FileMagic;
+    Header->Version = GeneratorVersion;
+    Header->KeyHash = Key.ComputeHash();
+    Header->Width = Key.Width;
+    Header->Height = Key.Height;
+    Header->NumTiles = NumTiles;
+    Header->PayloadCrc = FCrc::MemCrc32(Tiles, NumTiles * sizeof(FMapCacheTile));
+
+    const FString Path = GetCacheFilePath(Key);
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+
+    if (!FFileHelper::SaveArrayToFile(Buffer, *Path))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MapCache: Failed to write %s"), *Path);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("MapCache: Saved %s (%d tiles)"), *Path, NumTiles);
+    return true;
+}
+
+bool FMapCache::Load(const FMapCacheKey& Key, TFunctionRef<void(const FMapCacheTile* Tiles, int32 NumTiles)> Visitor)
+{
+    const FString Path = GetCacheFilePath(Key);
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.FileExists(*Path)) return false;
+
+    const int32 NumTiles = Key.Width * Key.Height;
+    const int64 ExpectedSize = sizeof(FHeader) + (int64)NumTiles * sizeof(FMapCacheTile);
+
+    bool bValid = false;
+    {
+        FOpenMappedResult MappedResult = PlatformFile.OpenMappedEx(*Path);
+        if (MappedResult.HasError()) return false;
+
+        TUniquePtr<IMappedFileHandle> Handle = MappedResult.StealValue();
+        if (Handle && Handle->GetFileSize() == ExpectedSize)
+        {
+            TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion(0, ExpectedSize));
+            if (Region)
+            {
+                const uint8* Data = Region->GetMappedPtr();
+                const FHeader* Header = reinterpret_cast<const FHeader*>(Data);
+                const FMapCacheTile* Tiles = reinterpret_cast<const FMapCacheTile*>(Data + sizeof(FHeader));
+
+                bValid = Header->Magic == FileMagic
+                    && Header->Version == GeneratorVersion
+                    && Header->KeyHash == Key.ComputeHash()
+                    && Header->Width == Key.Width
+                    && Header->Height == Key.Height
+                    && Header->NumTiles == (uint32)NumTiles
+                    && Header->PayloadCrc == FCrc::MemCrc32(Tiles, NumTiles * sizeof(FMapCacheTile));
+
+                if (bValid)
+                {
+                    Visitor(Tiles, NumTiles);
+                }
+            }
+        }
+    }
+
+    if (!bValid)
+    {
+        // 汾ļ𻵣ɾ
+        UE_LOG(LogTemp, Warning, TEXT("MapCache: Discarding stale cache %s"), *Path);
+        PlatformFile.DeleteFile(*Path);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("MapCache: Loaded %s"), *Path);
+    return true;
+}
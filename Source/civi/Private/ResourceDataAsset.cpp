@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ResourceDataAsset.h"
+#include "Misc/Crc.h"
+
+FResourceInfo UResourceDataAsset::GetResourceInfo(EResourceType Type) const
+{
+    for (const FResourceInfo& Info : Resources)
+    {
+        if (Info.ResourceType == Type)
+        {
+            return Info;
+        }
+    }
+    return FResourceInfo();
+}
+
+bool UResourceDataAsset::HasResourceFor(ETerrain Terrain, ELandform Landform) const
+{
+    for (const FResourceInfo& Info : Resources)
+    {
+        if (Info.CanPlaceOn(Terrain, Landform))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32 UResourceDataAsset::GetPlacementRulesHash() const
+{
+    uint32 Hash = FCrc::MemCrc32(&MinSpacing, sizeof(MinSpacing));
+    Hash = FCrc::MemCrc32(&PlacementChance, sizeof(PlacementChance), Hash);
+
+    for (const FResourceInfo& Info : Resources)
+    {
+        Hash = FCrc::MemCrc32(&Info.ResourceType, sizeof(Info.ResourceType), Hash);
+        Hash = FCrc::MemCrc32(&Info.Weight, sizeof(Info.Weight), Hash);
+        Hash = FCrc::MemCrc32(Info.ValidTerrains.GetData(), Info.ValidTerrains.Num() * sizeof(ETerrain), Hash);
+        Hash = FCrc::MemCrc32(Info.ValidLandforms.GetData(), Info.ValidLandforms.Num() * sizeof(ELandform), Hash);
+    }
+
+    return Hash;
+}
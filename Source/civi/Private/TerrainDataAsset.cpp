@@ -27,4 +27,9 @@ FLandformDisplayData UTerraindataasset::GetLandformDisplayData(ELandform Landfor
 
     // Ĭֵ
     return FLandformDisplayData();
+}
+
+const FLandformDisplayData* UTerraindataasset::FindLandformDisplayData(ELandform LandformType) const
+{
+    return LandformData.FindByPredicate([LandformType](const FLandformDisplayData& Data) { return Data.LandformType == LandformType; });
 }
\ No newline at end of file
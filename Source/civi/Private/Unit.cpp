@@ -5,6 +5,11 @@
 #include "UnitDataAsset.h"
 #include "City.h"
 #include "CombatFunctionLibrary.h"
+#include "Civi_GameModeBase.h"
+#include "HexPathfinder.h"
+#include "HexPathBatch.h"
+#include "HexMath.h"
+#include "HexVisibility.h"
 
 AUnit::AUnit()
 {
@@ -19,6 +24,23 @@ void AUnit::BeginPlay()
     Super::BeginPlay();
 }
 
+void AUnit::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // Ƴʱӿռɾ
+    if (ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>())
+    {
+        GM->GetUnitIndex().RemoveUnit(this, GridX, GridY);
+        GM->RemoveSightObserver(this);
+
+        if (CurrentBlock && ExertsZoneOfControl())
+        {
+            GM->UpdateZoneOfControl(PlayerOwnerIndex, GridX, GridY, -1);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void AUnit::InitUnit(ECiviUnitType Type, int32 OwnerIndex, ULandblock* StartBlock, UUnitDataAsset* DataAsset)
 {
     if (!DataAsset || !StartBlock) return;
@@ -30,6 +52,10 @@ void AUnit::InitUnit(ECiviUnitType Type, int32 OwnerIndex, ULandblock* StartBloc
     MaxMovementPoints = Info.MaxMovementPoints;
     MovementPoints = MaxMovementPoints;
     CombatStrength = Info.CombatStrength;
+    RangedStrength = Info.RangedStrength;
+    Range = Info.Range;
+    SightRange = FMath::Clamp(Info.SightRange, 1, FHexSightRays::MaxSightRadius);
+    MovementClass = Info.MovementClass;
     MaxHP = 100;
     CurrentHP = MaxHP;
     bIsFortified = false;
@@ -38,7 +64,18 @@ void AUnit::InitUnit(ECiviUnitType Type, int32 OwnerIndex, ULandblock* StartBloc
     CurrentBlock = StartBlock;
     GridX = StartBlock->X;
     GridY = StartBlock->Y;
-    StartBlock->OccupyingUnit = this;
+    StartBlock->SetOccupyingUnit(this);
+
+    if (ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>())
+    {
+        GM->GetUnitIndex().AddUnit(this, GridX, GridY);
+        GM->UpdateSightObserver(this, PlayerOwnerIndex, GridX, GridY, SightRange);
+
+        if (ExertsZoneOfControl())
+        {
+            GM->UpdateZoneOfControl(PlayerOwnerIndex, GridX, GridY, 1);
+        }
+    }
 
     // Ӿ
     if (Info.Mesh)
@@ -52,25 +89,26 @@ void AUnit::InitUnit(ECiviUnitType Type, int32 OwnerIndex, ULandblock* StartBloc
 
 void AUnit::UpdateWorldLocation()
 {
-    // 򵥸깫ʽȡͨù
-    float HexRadius = 100.0f; // Ҫ MapRenderer һ
-    float Width = HexRadius * 2.0f + 2.0f;
-    float Height = HexRadius * FMath::Sqrt(3.0f) + 2.0f;
+    // ͼȾʹͬһβ
+    ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>();
+    const FVector TilePos = GM ? GM->GetTileWorldPosition(GridX, GridY) : FHexLayout().TileToWorld(GridX, GridY);
 
-    float WorldX = GridX * Width * 0.75f;
-    float WorldY = GridY * Height;
-    if (GridX % 2 == 1) WorldY += Height * 0.5f;
-
-    SetActorLocation(FVector(WorldX, WorldY, 20.0f)); // Z̧һ⴩ģ
+    SetActorLocation(TilePos + FVector(0, 0, 20.0f)); // Z̧һ⴩ģ
 }
 
 bool AUnit::MoveTo(ULandblock* TargetBlock)
 {
     if (!TargetBlock || MovementPoints <= 0) return false;
-    if (TargetBlock == CurrentBlock) return false;
+    if (TargetBlock == CurrentBlock || !CurrentBlock) return false;
+
+    ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>();
+    if (!GM) return false;
+
+    const int32 GoalIndex = TargetBlock->Y * GM->MapWidth + TargetBlock->X;
+    const FMovementCostGrid& Costs = GM->GetMovementCosts();
 
-    // 1. ĿǷͨ
-    if (!TargetBlock->IsPassable())
+    // 1. ĿԱλƶǷͨ
+    if (!Costs.Costs.IsValidIndex(GoalIndex) || Costs.GetCost(MovementClass, GoalIndex) == 0)
     {
         UE_LOG(LogTemp, Warning, TEXT("Target is impassable"));
         return false;
@@ -90,49 +128,151 @@ bool AUnit::MoveTo(ULandblock* TargetBlock)
         }
     }
 
-    // 3. ƶ (򻯰棺ֻж)
-    // ʵĿҪ A* Ѱ·㷨ֳ֧
-    bool bIsNeighbor = false;
-    for (ULandblock* Neighbor : CurrentBlock->Neighbors)
+    // µƶָȡ֮ǰ
+    CurrentOrder = EUnitOrder::GoTo;
+    OrderGoalIndex = GoalIndex;
+    PendingPathVersion = GM->GetMovementCostVersion();
+
+    // 3. ĿڱغƶΧʱֱʹû·
+    if (GetReachableTiles().BuildPathTo(GoalIndex, PendingPath))
     {
-        if (Neighbor == TargetBlock)
-        {
-            bIsNeighbor = true;
-            break;
-        }
+        ContinuePendingMove();
+        return true;
     }
 
-    if (!bIsNeighbor)
+    // 4. A* Ѱ· (غϼģ߲Ĳ֮Ļغ)
+    FHexPathQuery Query;
+    Query.StartIndex = CurrentBlock->Y * GM->MapWidth + CurrentBlock->X;
+    Query.GoalIndex = GoalIndex;
+    Query.MaxMovementPoints = MaxMovementPoints;
+    Query.StartMovementPoints = MovementPoints;
+    Query.MovementClass = MovementClass;
+    Query.ZoneOfControlPlayer = PlayerOwnerIndex;
+
+    const FHexPathResult Result = GM->FindPathCached(Query, PendingPath);
+    if (!Result.bFound)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Unit can only move to neighbors directly (Pathfinding WIP)"));
+        UE_LOG(LogTemp, Warning, TEXT("No path to target (%d, %d)"), TargetBlock->X, TargetBlock->Y);
+        CancelOrder();
         return false;
     }
 
-    int32 Cost = TargetBlock->GetMovementCost();
-    if (MovementPoints < Cost)
+    UE_LOG(LogTemp, Log, TEXT("Path to (%d, %d): %d steps, %d turn(s)"), TargetBlock->X, TargetBlock->Y, PendingPath.Num(), Result.Turns);
+
+    // 5. ִбغߵĲ
+    ContinuePendingMove();
+
+    return true;
+}
+
+const FHexReachableSet& AUnit::GetReachableTiles()
+{
+    ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>();
+    if (!GM || !CurrentBlock)
+    {
+        CachedReachable.Reset();
+        bHasCachedReachable = false;
+        return CachedReachable;
+    }
+
+    const int32 OriginIndex = CurrentBlock->Y * GM->MapWidth + CurrentBlock->X;
+
+    // λúƶδ䣬뾶ûм¼仯ʱֱӸ (λĿาһ)
+    const bool bCacheValid = bHasCachedReachable
+        && CachedReachable.OriginIndex == OriginIndex
+        && CachedReachable.MovementPoints == MovementPoints
+        && !GM->HasMapChangedNear(CachedReachableSerial, OriginIndex, MovementPoints + 1);
+
+    if (!bCacheValid)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Not enough movement points"));
-        return false;
+        FHexPathfinder::FindReachable(GM->GetMovementCosts(), OriginIndex, MovementPoints, MaxMovementPoints, CachedReachable, MovementClass, PlayerOwnerIndex);
+        bHasCachedReachable = true;
     }
 
-    // 4. ִƶ
+    // ֻ֮µı仯
+    CachedReachableSerial = GM->GetMapChangeSerial();
+
+    return CachedReachable;
+}
+
+void AUnit::ContinuePendingMove()
+{
+    ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>();
+    if (!GM) return;
+
+    const FMovementCostGrid& Costs = GM->GetMovementCosts();
+
+    while (PendingPath.Num() > 0 && MovementPoints > 0)
+    {
+        const int32 NextIndex = PendingPath.Last();
+        ULandblock* NextBlock = GM->MapGrid.IsValidIndex(NextIndex) ? GM->MapGrid[NextIndex] : nullptr;
+        if (!NextBlock || Costs.GetCost(MovementClass, NextIndex) == 0)
+        {
+            // ͼ˱仯·ʧЧ
+            PendingPath.Reset();
+            break;
+        }
+
+        // λ赲»غٳ
+        if (NextBlock->HasUnit()) break;
+
+        const int32 CurrentIndex = CurrentBlock->Y * GM->MapWidth + CurrentBlock->X;
+        const int32 Cost = FHexPathfinder::ClampStepCost(Costs.GetStepCost(MovementClass, CurrentIndex, NextIndex), MaxMovementPoints);
+        if (MovementPoints < Cost) break;
+
+        StepTo(NextBlock, Cost);
+        PendingPath.Pop(EAllowShrinking::No);
+    }
+
+    // Ŀĵأǰ
+    if (CurrentOrder == EUnitOrder::GoTo && CurrentBlock && CurrentBlock->Y * GM->MapWidth + CurrentBlock->X == OrderGoalIndex)
+    {
+        CurrentOrder = EUnitOrder::None;
+        OrderGoalIndex = INDEX_NONE;
+    }
+}
+
+void AUnit::StepTo(ULandblock* NextBlock, int32 Cost)
+{
     // ɵؿ
-    if (CurrentBlock) CurrentBlock->OccupyingUnit = nullptr;
+    if (CurrentBlock) CurrentBlock->SetOccupyingUnit(nullptr);
+
+    ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>();
+    if (GM)
+    {
+        GM->GetUnitIndex().MoveUnit(this, GridX, GridY, NextBlock->X, NextBlock->Y);
+
+        if (ExertsZoneOfControl())
+        {
+            GM->UpdateZoneOfControl(PlayerOwnerIndex, GridX, GridY, -1);
+            GM->UpdateZoneOfControl(PlayerOwnerIndex, NextBlock->X, NextBlock->Y, 1);
+        }
+    }
 
     // ״̬
     MovementPoints -= Cost;
-    CurrentBlock = TargetBlock;
-    GridX = TargetBlock->X;
-    GridY = TargetBlock->Y;
+    CurrentBlock = NextBlock;
+    GridX = NextBlock->X;
+    GridY = NextBlock->Y;
     bIsFortified = false; // ƶȡפ
 
+    // ֻ½뿪Ұĵؿ
+    if (GM)
+    {
+        GM->UpdateSightObserver(this, PlayerOwnerIndex, GridX, GridY, SightRange);
+    }
+
+    // зغϲܼƶ
+    if (GM && GM->GetMovementCosts().IsInZoneOfControl(PlayerOwnerIndex, GridY * GM->MapWidth + GridX))
+    {
+        MovementPoints = 0;
+    }
+
     // 
-    TargetBlock->OccupyingUnit = this;
+    NextBlock->SetOccupyingUnit(this);
 
     // Ӿ
     UpdateWorldLocation();
-
-    return true;
 }
 
 void AUnit::AttackUnit(AUnit* Defender)
@@ -164,7 +304,7 @@ void AUnit::AttackUnit(AUnit* Defender)
         Defender->Destroy();
         if (Defender->CurrentBlock)
         {
-            Defender->CurrentBlock->OccupyingUnit = nullptr;
+            Defender->CurrentBlock->SetOccupyingUnit(nullptr);
             // սʤפ
             MoveTo(Defender->CurrentBlock);
         }
@@ -173,7 +313,7 @@ void AUnit::AttackUnit(AUnit* Defender)
     if (this->CurrentHP <= 0)
     {
         this->Destroy();
-        if (CurrentBlock) CurrentBlock->OccupyingUnit = nullptr;
+        if (CurrentBlock) CurrentBlock->SetOccupyingUnit(nullptr);
     }
 }
 
@@ -219,11 +359,17 @@ void AUnit::FoundCity()
 
         // 
         NewCity->AddTerritory(CurrentBlock);
+
+        // ҰڿʧǰǼǣؿݱ
+        if (ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>())
+        {
+            GM->UpdateSightObserver(NewCity, PlayerOwnerIndex, GridX, GridY, FHexVisibility::CitySightRadius);
+        }
         // ΧһȦؿ...
 
         // Ŀ
         this->Destroy();
-        CurrentBlock->OccupyingUnit = nullptr;
+        CurrentBlock->SetOccupyingUnit(nullptr);
     }
 }
 
@@ -231,14 +377,214 @@ void AUnit::Fortify()
 {
     if (MovementPoints > 0)
     {
+        CancelOrder();
         bIsFortified = true;
         MovementPoints = 0; // פؽغ
     }
 }
 
+void AUnit::Sleep()
+{
+    CancelOrder();
+    CurrentOrder = EUnitOrder::Sleep;
+}
+
+void AUnit::Alert()
+{
+    CancelOrder();
+    CurrentOrder = EUnitOrder::Alert;
+}
+
+void AUnit::AutoExplore()
+{
+    CancelOrder();
+    CurrentOrder = EUnitOrder::Explore;
+
+    ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>();
+    if (!GM || MovementPoints <= 0) return;
+
+    // غϻƶʱ֮ĻغɻغϿʼ
+    FHexPathQuery Query;
+    if (PrepareTurnOrder(Query))
+    {
+        FHexPathBatchResult Result;
+        Result.Result = GM->FindPathCached(Query, Result.Path);
+        ApplyOrderPath(Result);
+        ContinuePendingMove();
+    }
+}
+
+void AUnit::FortifyUntilHealed()
+{
+    Fortify();
+    if (bIsFortified)
+    {
+        CurrentOrder = EUnitOrder::FortifyUntilHealed;
+    }
+}
+
+void AUnit::CancelOrder()
+{
+    PendingPath.Reset();
+    CurrentOrder = EUnitOrder::None;
+    OrderGoalIndex = INDEX_NONE;
+    BlockedStepIndex = INDEX_NONE;
+}
+
+bool AUnit::PrepareTurnOrder(FHexPathQuery& OutQuery)
+{
+    ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>();
+    if (!GM || !CurrentBlock) return false;
+
+    const int32 CurrentIndex = GridY * GM->MapWidth + GridX;
+    const bool bPathUpToDate = PendingPath.Num() > 0 && PendingPathVersion == GM->GetMovementCostVersion();
+
+    switch (CurrentOrder)
+    {
+    case EUnitOrder::Alert:
+        if (GM->FindNearestEnemyUnit(PlayerOwnerIndex, GridX, GridY, AlertRadius))
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("%s woke up: enemy unit nearby"), *GetName());
+            CurrentOrder = EUnitOrder::None;
+        }
+        return false;
+
+    case EUnitOrder::FortifyUntilHealed:
+        if (CurrentHP >= MaxHP)
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("%s woke up: fully healed"), *GetName());
+            CurrentOrder = EUnitOrder::None;
+            bIsFortified = false;
+        }
+        return false;
+
+    case EUnitOrder::GoTo:
+        if (CurrentIndex == OrderGoalIndex)
+        {
+            CancelOrder();
+            return false;
+        }
+        // ·ȻЧֱӼҪѰ·
+        if (bPathUpToDate) return false;
+        break;
+
+    case EUnitOrder::Explore:
+        // Ŀδ̽ʱǰ
+        if (bPathUpToDate && GM->MapGrid.IsValidIndex(OrderGoalIndex)
+            && GM->MapGrid[OrderGoalIndex]->GetVisibility(PlayerOwnerIndex) == EVisibilityState::Unexplored)
+        {
+            return false;
+        }
+
+        OrderGoalIndex = FindExploreTarget();
+        if (OrderGoalIndex == INDEX_NONE)
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("%s has nothing left to explore"), *GetName());
+            CancelOrder();
+            return false;
+        }
+        break;
+
+    default:
+        return false;
+    }
+
+    OutQuery.StartIndex = CurrentIndex;
+    OutQuery.GoalIndex = OrderGoalIndex;
+    OutQuery.MaxMovementPoints = MaxMovementPoints;
+    OutQuery.StartMovementPoints = MovementPoints;
+    OutQuery.MovementClass = MovementClass;
+    OutQuery.ZoneOfControlPlayer = PlayerOwnerIndex;
+    OutQuery.AvoidIndex = BlockedStepIndex;
+    BlockedStepIndex = INDEX_NONE;
+    return true;
+}
+
+void AUnit::ApplyOrderPath(FHexPathBatchResult& Result)
+{
+    ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>();
+    if (!GM) return;
+
+    if (!Result.Result.bFound)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s: order target is no longer reachable"), *GetName());
+        CancelOrder();
+        return;
+    }
+
+    PendingPath = MoveTemp(Result.Path);
+    PendingPathVersion = GM->GetMovementCostVersion();
+}
+
+bool AUnit::ExecuteOrderMove()
+{
+    if (CurrentOrder != EUnitOrder::GoTo && CurrentOrder != EUnitOrder::Explore) return false;
+    if (PendingPath.Num() == 0 || MovementPoints <= 0) return false;
+
+    const int32 StartMP = MovementPoints;
+    ContinuePendingMove();
+    return MovementPoints != StartMP;
+}
+
+void AUnit::MarkBlockedOrderPath()
+{
+    if (CurrentOrder != EUnitOrder::GoTo && CurrentOrder != EUnitOrder::Explore) return;
+    if (PendingPath.Num() == 0 || MovementPoints <= 0) return;
+
+    ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>();
+    if (!GM) return;
+
+    const int32 NextIndex = PendingPath.Last();
+    const ULandblock* NextBlock = GM->MapGrid.IsValidIndex(NextIndex) ? GM->MapGrid[NextIndex] : nullptr;
+    if (!NextBlock || !NextBlock->HasUnit()) return;
+
+    // Ŀĵرռݣ޷ƿѵλȴָ
+    if (CurrentOrder == EUnitOrder::GoTo && NextIndex == OrderGoalIndex)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("%s woke up: destination is occupied"), *GetName());
+        CancelOrder();
+        return;
+    }
+
+    // ·汾뵱ǰ汾ͬΪʧЧ»غϿʼʱѰ·
+    BlockedStepIndex = NextIndex;
+    PendingPathVersion = GM->GetMovementCostVersion() - 1;
+}
+
+int32 AUnit::FindExploreTarget() const
+{
+    ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>();
+    if (!GM) return INDEX_NONE;
+
+    const FMovementCostGrid& Costs = GM->GetMovementCosts();
+    const int32 OriginIndex = GridY * GM->MapWidth + GridX;
+
+    // ɽԶ𻷲ңͬһȡ˳еĵһ
+    for (int32 Ring = 1; Ring <= ExploreRadius; Ring++)
+    {
+        int32 Found = INDEX_NONE;
+        FHexMath::ForEachInRing(GridX, GridY, Ring, GM->MapWidth, GM->MapHeight, [&](int32 Index, int32)
+        {
+            if (Found != INDEX_NONE || !Costs.AreConnected(MovementClass, OriginIndex, Index)) return;
+
+            const ULandblock* Block = GM->MapGrid.IsValidIndex(Index) ? GM->MapGrid[Index] : nullptr;
+            if (Block && !Block->HasUnit() && Block->GetVisibility(PlayerOwnerIndex) == EVisibilityState::Unexplored)
+            {
+                Found = Index;
+            }
+        });
+
+        if (Found != INDEX_NONE) return Found;
+    }
+    return INDEX_NONE;
+}
+
 void AUnit::OnTurnStart()
 {
     MovementPoints = MaxMovementPoints;
+
+    //  (·ѵ)  GameMode ڻغϿʼͳһִ
+
     // פУԻظHP
     if (bIsFortified && CurrentHP < MaxHP)
     {
@@ -246,6 +592,22 @@ void AUnit::OnTurnStart()
     }
 }
 
+bool AUnit::IsInRange(int32 TargetX, int32 TargetY) const
+{
+    ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>();
+    if (!GM) return false;
+
+    return FHexMath::Distance(GridX, GridY, TargetX, TargetY, GM->MapWidth) <= Range;
+}
+
+bool AUnit::ExertsZoneOfControl() const
+{
+    // ƽλûп
+    if (UnitType == ECiviUnitType::None || UnitType == ECiviUnitType::Settler || UnitType == ECiviUnitType::Builder) return false;
+
+    return CombatStrength > 0;
+}
+
 int32 AUnit::GetDefensiveStrength() const
 {
     int32 FinalStr = CombatStrength;
@@ -295,27 +657,72 @@ void AUnit::AttackCity(ACity* TargetCity)
     if (this->CurrentHP <= 0)
     {
         this->Destroy();
-        if (CurrentBlock) CurrentBlock->OccupyingUnit = nullptr;
+        if (CurrentBlock) CurrentBlock->SetOccupyingUnit(nullptr);
     }
 }
 
+bool AUnit::AdvanceOnCity(ACity* TargetCity)
+{
+    if (!TargetCity || !CurrentBlock || MovementPoints <= 0) return false;
+
+    ACivi_GameModeBase* GM = GetWorld()->GetAuthGameMode<ACivi_GameModeBase>();
+    if (!GM) return false;
+
+    const int32 CityIndex = TargetCity->GridY * GM->MapWidth + TargetCity->GridX;
+    const TSharedRef<const FHexFlowField> Field = GM->GetFlowField(MakeArrayView(&CityIndex, 1), MaxMovementPoints, MovementClass);
+
+    int32 CurrentIndex = CurrentBlock->Y * GM->MapWidth + CurrentBlock->X;
+    if (!Field->IsReachable(CurrentIndex))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("City at (%d, %d) is unreachable"), TargetCity->GridX, TargetCity->GridY);
+        return false;
+    }
+
+    // ȡ֮ǰ·
+    PendingPath.Reset();
+
+    const FMovementCostGrid& Costs = GM->GetMovementCosts();
+    bool bActed = false;
+
+    while (MovementPoints > 0)
+    {
+        const int32 NextIndex = Field->GetNextIndex(CurrentIndex);
+        if (NextIndex == INDEX_NONE) break;
+
+        // һǳУ𹥳
+        if (Field->IsTarget(NextIndex))
+        {
+            AttackCity(TargetCity);
+            return true;
+        }
+
+        ULandblock* NextBlock = GM->MapGrid.IsValidIndex(NextIndex) ? GM->MapGrid[NextIndex] : nullptr;
+        if (!NextBlock || NextBlock->HasUnit()) break;
+
+        const int32 Cost = FHexPathfinder::ClampStepCost(Costs.GetStepCost(MovementClass, CurrentIndex, NextIndex), MaxMovementPoints);
+        if (MovementPoints < Cost) break;
+
+        StepTo(NextBlock, Cost);
+        CurrentIndex = NextIndex;
+        bActed = true;
+    }
+
+    return bActed;
+}
+
 void AUnit::RangedAttackUnit(AUnit* TargetUnit)
 {
     // 飺Զδƶ(רŵĹ)
-    //  Range Ѿ UUnitDataAsset ж壬ȷ InitUnit ʱȡ Unit Ա
-    //  Unit.h  RangedStrength  Range Ա (ȷ DataAsset ֵ)
+    if (!TargetUnit || MovementPoints <= 0 || RangedStrength <= 0) return;
 
-    if (!TargetUnit || MovementPoints <= 0) return;
-
-    // ׾ (پξ)
-    // int32 Dist = FMath::Max(FMath::Abs(GridX - TargetUnit->GridX), FMath::Abs(GridY - TargetUnit->GridY)); // 
-    // if (Dist > Range) return;
+    // ̼ (ξ룬ǵͼ)
+    if (!IsInRange(TargetUnit->GridX, TargetUnit->GridY)) return;
 
     MovementPoints = 0;
     bIsFortified = false;
 
     // Զ̹߲ܷ˺
-    int32 MyRangedStr = 20; // ݶʵӦ Unit Զȡ
+    int32 MyRangedStr = RangedStrength;
     int32 DefStr = TargetUnit->GetDefensiveStrength();
 
     int32 Dmg = UCombatFunctionLibrary::CalculateDamage(MyRangedStr, DefStr);
@@ -324,17 +731,18 @@ void AUnit::RangedAttackUnit(AUnit* TargetUnit)
     if (TargetUnit->CurrentHP <= 0)
     {
         TargetUnit->Destroy();
-        if (TargetUnit->CurrentBlock) TargetUnit->CurrentBlock->OccupyingUnit = nullptr;
+        if (TargetUnit->CurrentBlock) TargetUnit->CurrentBlock->SetOccupyingUnit(nullptr);
     }
 }
 
 void AUnit::RangedAttackCity(ACity* TargetCity)
 {
-    if (!TargetCity || MovementPoints <= 0) return;
+    if (!TargetCity || MovementPoints <= 0 || RangedStrength <= 0) return;
+    if (!IsInRange(TargetCity->GridX, TargetCity->GridY)) return;
 
     MovementPoints = 0;
 
-    int32 MyRangedStr = 20; // Զȡ
+    int32 MyRangedStr = RangedStrength;
     int32 CityStr = TargetCity->CombatStrength;
 
     // Զ̹ǣܻܼ⣬Ϊֱ˺
@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UnitSpatialIndex.h"
+#include "Unit.h"
+#include "HexMath.h"
+
+void FUnitSpatialIndex::Reset(int32 InWidth, int32 InHeight)
+{
+    Width = InWidth;
+    Height = InHeight;
+    CellsX = FMath::Max(1, FMath::DivideAndRoundUp(Width, CellSize));
+    CellsY = FMath::Max(1, FMath::DivideAndRoundUp(Height, CellSize));
+    NumUnits = 0;
+
+    Players.Reset();
+}
+
+FUnitSpatialIndex::FPlayerCells* FUnitSpatialIndex::GetOrAddPlayer(int32 PlayerIndex)
+{
+    if (PlayerIndex < 0 || Width <= 0) return nullptr;
+
+    while (Players.Num() <= PlayerIndex)
+    {
+        Players.AddDefaulted_GetRef().SetNum(CellsX * CellsY);
+    }
+    return &Players[PlayerIndex];
+}
+
+int32 FUnitSpatialIndex::GetUnitDistance(const AUnit* Unit, int32 X, int32 Y) const
+{
+    return FHexMath::Distance(X, Y, Unit->GridX, Unit->GridY, Width);
+}
+
+void FUnitSpatialIndex::AddUnit(AUnit* Unit, int32 X, int32 Y)
+{
+    if (!Unit || X < 0 || X >= Width || Y < 0 || Y >= Height) return;
+
+    if (FPlayerCells* Cells = GetOrAddPlayer(Unit->PlayerOwnerIndex))
+    {
+        (*Cells)[GetCellIndex(X, Y)].Add(Unit);
+        NumUnits++;
+    }
+}
+
+void FUnitSpatialIndex::RemoveUnit(AUnit* Unit, int32 X, int32 Y)
+{
+    if (!Unit || !Players.IsValidIndex(Unit->PlayerOwnerIndex)) return;
+    if (X < 0 || X >= Width || Y < 0 || Y >= Height) return;
+
+    FPlayerCells& Cells = Players[Unit->PlayerOwnerIndex];
+    if (Cells[GetCellIndex(X, Y)].RemoveSingleSwap(Unit, EAllowShrinking::No) > 0)
+    {
+        NumUnits--;
+    }
+}
+
+void FUnitSpatialIndex::MoveUnit(AUnit* Unit, int32 FromX, int32 FromY, int32 ToX, int32 ToY)
+{
+    if (Width <= 0) return;
+    if (GetCellIndex(FromX, FromY) == GetCellIndex(ToX, ToY)) return;
+
+    RemoveUnit(Unit, FromX, FromY);
+    AddUnit(Unit, ToX, ToY);
+}
+
+void FUnitSpatialIndex::GetUnitsInRadius(int32 PlayerIndex, int32 X, int32 Y, int32 Radius, TArray<AUnit*>& OutUnits) const
+{
+    OutUnits.Reset();
+    ForEachUnitInRadius(PlayerIndex, X, Y, Radius, [&OutUnits](AUnit* Unit, int32 Distance)
+    {
+        OutUnits.Add(Unit);
+    });
+}
+
+AUnit* FUnitSpatialIndex::FindNearestEnemy(int32 PlayerIndex, int32 X, int32 Y, int32 MaxRadius, int32* OutDistance) const
+{
+    if (Width <= 0 || MaxRadius < 0) return nullptr;
+
+    AUnit* Best = nullptr;
+    int32 BestDist = MaxRadius + 1;
+
+    const int32 CenterCellX = X / CellSize;
+    const int32 CenterCellY = Y / CellSize;
+    const int32 LoLimit = CellsX / 2;
+    const int32 HiLimit = (CellsX - 1) / 2;
+    const int32 MaxRing = FMath::Min(MaxRadius / CellSize + 2, FMath::Max(LoLimit + 1, CellsY));
+
+    // ӻɽԶ
+    // ξ벻Сƫбѩ룬 Ring ĵλ (Ring - 1) * CellSize (ĩиӿܽխٱһ)
+    for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+    {
+        if (Best && BestDist <= (Ring - 1) * CellSize) break;
+
+        const int32 LoDX = -FMath::Min(Ring, LoLimit);
+        const int32 HiDX = FMath::Min(Ring, HiLimit);
+
+        for (int32 DY = -Ring; DY <= Ring; DY++)
+        {
+            const int32 CellY = CenterCellY + DY;
+            if (CellY < 0 || CellY >= CellsY) continue;
+
+            for (int32 DX = LoDX; DX <= HiDX; DX++)
+            {
+                // ֻʱϵĸ
+                if (FMath::Max(FMath::Abs(DX), FMath::Abs(DY)) != Ring) continue;
+
+                const int32 CellIndex = CellY * CellsX + WrapCellX(CenterCellX + DX);
+                for (int32 Player = 0; Player < Players.Num(); Player++)
+                {
+                    if (Player == PlayerIndex) continue;
+
+                    for (const TWeakObjectPtr<AUnit>& Handle : Players[Player][CellIndex])
+                    {
+                        AUnit* Unit = Handle.Get();
+                        if (!Unit) continue;
+
+                        const int32 Dist = GetUnitDistance(Unit, X, Y);
+                        if (Dist < BestDist)
+                        {
+                            Best = Unit;
+                            BestDist = Dist;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (OutDistance && Best)
+    {
+        *OutDistance = BestDist;
+    }
+    return Best;
+}
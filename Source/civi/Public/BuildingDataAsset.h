@@ -56,4 +56,7 @@ public:
 
     UFUNCTION(BlueprintCallable, Category = "Building Data")
     FBuildingDisplayData GetBuildingDisplayData(EBuildingType Type) const;
+
+    // ƵĲңδʱؿ
+    const FBuildingDisplayData* FindBuildingDisplayData(EBuildingType Type) const;
 };
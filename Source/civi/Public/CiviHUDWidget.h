@@ -34,6 +34,11 @@ public:
     UFUNCTION(BlueprintImplementableEvent, Category = "Civi UI")
     void UpdateTilePanel(ETerrain Terrain, ELandform Landform, bool bIsVisible);
 
+    // ؿĽ (-1 Ϊ) ͳ ( UpdateTilePanel )
+    // Ϊǰе״̬еĵؿʾ󿴵
+    UFUNCTION(BlueprintImplementableEvent, Category = "Civi UI")
+    void UpdateTilePanelSeen(EBuildingType Building, int32 OwnerPlayer, bool bHasCity, bool bIsVisible);
+
     // --- ťص ( UI ť󶨵) ---
 
     // غϰť
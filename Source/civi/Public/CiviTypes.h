@@ -75,16 +75,16 @@ enum class ELandform : uint8
     Ice         UMETA(DisplayName = "")
 };
 
-// ηö
+// ηö (ƽΣ˳ʱ룻Է 3)
 UENUM(BlueprintType)
 enum class EHexDirection : uint8
 {
     NorthEast = 0   UMETA(DisplayName = ""),
-    East = 1        UMETA(DisplayName = ""),
-    SouthEast = 2   UMETA(DisplayName = ""),
+    SouthEast = 1   UMETA(DisplayName = ""),
+    South = 2       UMETA(DisplayName = ""),
     SouthWest = 3   UMETA(DisplayName = ""),
-    West = 4        UMETA(DisplayName = ""),
-    NorthWest = 5   UMETA(DisplayName = "")
+    NorthWest = 4   UMETA(DisplayName = ""),
+    North = 5       UMETA(DisplayName = "")
 };
 
 // ö
@@ -99,6 +99,42 @@ enum class EBuildingType : uint8
     Pasture     UMETA(DisplayName = "")
 };
 
+// Դ
+UENUM(BlueprintType)
+enum class EResourceClass : uint8
+{
+    Bonus       UMETA(DisplayName = "ӳԴ"),
+    Luxury      UMETA(DisplayName = "ݳԴ"),
+    Strategic   UMETA(DisplayName = "սԴ")
+};
+
+// Դö
+UENUM(BlueprintType)
+enum class EResourceType : uint8
+{
+    None        UMETA(DisplayName = ""),
+    // ӳԴ
+    Wheat       UMETA(DisplayName = "С"),
+    Rice        UMETA(DisplayName = "ˮ"),
+    Cattle      UMETA(DisplayName = "ţ"),
+    Sheep       UMETA(DisplayName = ""),
+    Deer        UMETA(DisplayName = "¹"),
+    Stone       UMETA(DisplayName = "ʯͷ"),
+    Fish        UMETA(DisplayName = ""),
+    // ݳԴ
+    Wine        UMETA(DisplayName = "Ѿ"),
+    Cotton      UMETA(DisplayName = "޻"),
+    Silk        UMETA(DisplayName = "˿"),
+    Spices      UMETA(DisplayName = ""),
+    Furs        UMETA(DisplayName = "Ƥ"),
+    Diamonds    UMETA(DisplayName = "ʯ"),
+    // սԴ
+    Horses      UMETA(DisplayName = ""),
+    Iron        UMETA(DisplayName = ""),
+    Niter       UMETA(DisplayName = "ʯ"),
+    Coal        UMETA(DisplayName = "ú")
+};
+
 // ö
 UENUM(BlueprintType)
 enum class EWonderType : uint8
@@ -122,6 +158,17 @@ enum class ECiviUnitType : uint8
     Archer      UMETA(DisplayName = "")
 };
 
+// ƶ (Ѱ·ʹЩĲ)
+UENUM(BlueprintType)
+enum class EMovementClass : uint8
+{
+    Land        UMETA(DisplayName = "½"),       // ֻ½ƶ
+    Amphibious  UMETA(DisplayName = "ɵǴ"),     // ½ + ǴǳǴ/½ж
+    Naval       UMETA(DisplayName = "ֻ"),   // ֻǳƶ
+    OceanGoing  UMETA(DisplayName = "Զֻ"),   // ǳ + 
+    Count       UMETA(Hidden)
+};
+
 // λж
 UENUM(BlueprintType)
 enum class EUnitAction : uint8
@@ -133,6 +180,18 @@ enum class EUnitAction : uint8
     Sleep       UMETA(DisplayName = "")
 };
 
+// λĳ (غϱغϿʼʱͳһִ)
+UENUM(BlueprintType)
+enum class EUnitOrder : uint8
+{
+    None                UMETA(DisplayName = ""),
+    GoTo                UMETA(DisplayName = "ǰ"),          // ر·ǰ
+    Sleep               UMETA(DisplayName = ""),          // Ҫָֱһ
+    Alert               UMETA(DisplayName = ""),          // ֵзλʱ
+    Explore             UMETA(DisplayName = "Զ̽"),      // ǰδ̽ؿ
+    FortifyUntilHealed  UMETA(DisplayName = "פȬ")     // פػѪѪʱ
+};
+
 // λս
 UENUM(BlueprintType)
 enum class ECombatResult : uint8
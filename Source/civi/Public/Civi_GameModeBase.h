@@ -9,12 +9,25 @@
 #include "TerrainDataAsset.h"
 #include "TechDataAsset.h"
 #include "CivicDataAsset.h"
+#include "ResourceDataAsset.h"
+#include "MapCache.h"
+#include "HexPathfinder.h"
+#include "HexHierarchicalPathfinder.h"
+#include "HexPathBatch.h"
+#include "HexPathCache.h"
+#include "HexFlowField.h"
+#include "HexLandmarks.h"
+#include "UnitSpatialIndex.h"
+#include "HexVisibility.h"
+#include "HexTileMemory.h"
+#include "HexMath.h"
 #include "Civi_GameModeBase.generated.h"
 
 class ULandblock;
 class ACity;
 class AUnit;
 class AHexMapRenderer;
+class UBuilding;
 
 // з״̬ṹ
 USTRUCT(BlueprintType)
@@ -63,7 +76,7 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Map Generation")
     void InitMap();
 
-    // ͼߴ (С͵ͼ 74x46)
+    // ͼߴ (С͵ͼ 74x46ΪżX ʱӷżܽ)
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Settings")
     int32 MapWidth = 74;
 
@@ -93,10 +106,25 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise Settings")
     float Lacunarity = 2.0f;
 
+    // ʹöɵͼ (λһ£ͬͻعҪ)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise Settings")
+    bool bUseFixedPointNoise = true;
+
+    // Ƿʹô̵ͼ (ͬӺͲֱӶȡ)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Settings")
+    bool bUseMapCache = true;
+
     // ͼ (άһάʾ)
     UPROPERTY(BlueprintReadOnly, Category = "Map Data")
     TArray<ULandblock*> MapGrid;
 
+    // ͼУ (/ò//Դ CRC32)ڶԱȲͬɵĵͼ
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Map Data")
+    int32 MapChecksum = 0;
+
+    UFUNCTION(BlueprintCallable, Category = "Map Data")
+    int32 GetMapChecksum() const { return MapChecksum; }
+
     //غϵͳ
 
     // ǰغ (1ʼ)
@@ -133,6 +161,10 @@ public:
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Game Data")
     UBuildingDataAsset* GlobalBuildingData;
 
+    // Դù
+    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Game Data")
+    UResourceDataAsset* GlobalResourceData;
+
     // ȡҵǰԴ
     UFUNCTION(BlueprintCallable, Category = "Economy")
     FYields GetPlayerResources(int32 PlayerIndex) const;
@@ -170,10 +202,152 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Research")
     bool IsTechUnlocked(int32 PlayerIndex, ETechType Tech) const;
 
-    // ҵӦĵؿ
+    // ҵӦĵؿ (O(1)ȾĲһ)
     UFUNCTION(BlueprintCallable, Category = "Map Helper")
     ULandblock* GetLandblockFromWorldPos(FVector WorldPos);
 
+    // ͼȾʹõβ (ûȾʱʹĬϳߴ)
+    FHexLayout GetHexLayout();
+
+    // ؿĵ (Ⱦı任)
+    FVector GetTileWorldPosition(int32 X, int32 Y);
+
+    // еĵͼȾ (һκ󻺴)
+    AHexMapRenderer* FindMapRenderer();
+
+    // --- Ѱ· ---
+
+    // Ѱ·ʹõƶ
+    const FMovementCostGrid& GetMovementCosts() const { return MovementCosts; }
+
+    // ݵǰͼ͵ιؽƶ
+    void RebuildMovementCosts();
+
+    // ƶİ汾 (ؽα仯ʱһ)λݴжϱ·ǷҪ¼
+    uint32 GetMovementCostVersion() const { return MovementCostVersion; }
+
+    // ̨ڵǰͼͼִѰ·ѯ (Ϊ 0 ʱʹĬֵ 512x512, 1000 )
+    UFUNCTION(Exec, Category = "Pathfinding")
+    void BenchmarkPathfinding(int32 Width, int32 Height, int32 NumQueries);
+
+    //  A* Ѱ· (λƶʹ)·߾α仯ʱʧЧ
+    FHexPathResult FindPathCached(const FHexPathQuery& Query, TArray<int32>& OutPath);
+
+    const FHexPathCache& GetPathCache() const { return PathCache; }
+
+    // ̨·/δͳ
+    UFUNCTION(Exec, Category = "Pathfinding")
+    void DumpPathCacheStats();
+
+    // Ŀؿ鼯ǰ (Ŀꡢƶƶ𻺴棬λ)
+    TSharedRef<const FHexFlowField> GetFlowField(TConstArrayView<int32> TargetIndices, int32 MaxMovementPoints, EMovementClass MovementClass = EMovementClass::Land);
+
+    // ǰƶĵĲɱ (̨߳Ѱ·ȡ)
+    TSharedRef<const FMovementCostGrid> MakeMovementCostSnapshot() const;
+
+    // Ѱ· (AI غϿʼԶƶ)ڹִ߳УһһӦ
+    TArray<TFuture<FHexPathBatchResult>> SubmitPathBatch(const TArray<FHexPathQuery>& Queries);
+
+    // ̨Ѱ· 1/4/16 µ (Ϊ 0 ʱʹĬֵ 512x512, 2000 )
+    UFUNCTION(Exec, Category = "Pathfinding")
+    void BenchmarkPathBatch(int32 Width, int32 Height, int32 NumQueries);
+
+    // ԶֲѰ· (AI ·߹滮·)ֻϸһڵ·
+    bool FindHierarchicalPath(int32 StartIndex, int32 GoalIndex, int32 MaxMovementPoints, FHexHierarchicalPath& OutPath);
+
+    // ̨Ա A* ͷֲѰ·Զѯ (Ϊ 0 ʱʹĬֵ 2048x1024, 50 )
+    UFUNCTION(Exec, Category = "Pathfinding")
+    void BenchmarkHierarchicalPathfinding(int32 Width, int32 Height, int32 NumQueries);
+
+    // ں̨߳ؽر (ǰѰ·˻ξ)
+    void RequestLandmarkRebuild();
+
+    // ̨Աξ͵رչڵʱ (Ϊ 0 ʱʹĬֵ 1024x512, 200 )
+    UFUNCTION(Exec, Category = "Pathfinding")
+    void BenchmarkLandmarks(int32 Width, int32 Height, int32 NumQueries);
+
+    // ̨ 74x46  512x512 ͼ϶Աȵ̺߳ͲȾ׼ (ͳơռʵ任) ĺʱ (Ϊ 0 ʱÿߴִ 10 )
+    UFUNCTION(Exec, Category = "Map Renderer")
+    void BenchmarkRenderPrep(int32 NumRuns);
+
+    // --- λռ ---
+
+    // һֵĵλռϣ ( AUnit ڳƶʱά)
+    FUnitSpatialIndex& GetUnitIndex() { return UnitIndex; }
+    const FUnitSpatialIndex& GetUnitIndex() const { return UnitIndex; }
+
+    //  PlayerIndex  (X, Y) 뾶 Radius ڵĵλ
+    UFUNCTION(BlueprintCallable, Category = "Map Helper")
+    TArray<AUnit*> GetUnitsInRadius(int32 PlayerIndex, int32 X, int32 Y, int32 Radius) const;
+
+    //  (X, Y) ĵзλ ( PlayerIndex)MaxRadius ûʱؿ
+    UFUNCTION(BlueprintCallable, Category = "Map Helper")
+    AUnit* FindNearestEnemyUnit(int32 PlayerIndex, int32 X, int32 Y, int32 MaxRadius) const;
+
+    //  PlayerIndex һȴָĵλ ( After ֮ѭ)ûʱؿ
+    UFUNCTION(BlueprintCallable, Category = "Map Helper")
+    AUnit* FindNextUnitNeedingOrders(int32 PlayerIndex, AUnit* After) const;
+
+    // ---  ---
+
+    //  OwnerPlayer ľµλ (Delta = 1) 뿪 (Delta = -1) ؿ ( AUnit )
+    void UpdateZoneOfControl(int32 OwnerPlayer, int32 X, int32 Y, int32 Delta);
+
+    // ؿǷڶ PlayerIndex ĵз
+    UFUNCTION(BlueprintCallable, Category = "Map Helper")
+    bool IsInEnemyZoneOfControl(int32 PlayerIndex, int32 X, int32 Y) const;
+
+    // --- Ұ ---
+
+    const FHexVisibility& GetVisibility() const { return Visibility; }
+
+    // Ǽǻƶ۲ (λ/ƶн/ʱ)ֻ½뿪Ұĵؿ
+    void UpdateSightObserver(AActor* Observer, int32 PlayerIndex, int32 X, int32 Y, int32 Radius);
+
+    // ۲ߵҰ (λƳ)
+    void RemoveSightObserver(AActor* Observer);
+
+    // ѵǼǵĹ۲¼ҵȫҰдظؿҰ״̬
+    UFUNCTION(BlueprintCallable, Category = "FogOfWar")
+    void RecomputeVisibility(int32 PlayerIndex);
+
+    // һлʾʱ͸Ⱦĵؿͺʱ
+    int32 GetLastVisibilitySwitchTiles() const { return LastVisibilitySwitchTiles; }
+    double GetLastVisibilitySwitchSeconds() const { return LastVisibilitySwitchSeconds; }
+
+    // ---  ---
+
+    const FHexTileMemory& GetTileMemory() const { return TileMemory; }
+
+    // ؿĽмı ( ULandblock  ACity ޸ǰ)
+    void NotifyTileStateChanging(ULandblock* Block);
+
+    // еĵؿ飺б仯ĵؿ鷵󿴵ӣδ̽ĵؿ鷵ؿտ
+    FHexTileSnapshot GetTileAsSeenBy(int32 PlayerIndex, const ULandblock* Block) const;
+
+    // ؿĵΡò۸ıֻ¸õؿȾʵ
+    void RefreshTileVisuals(ULandblock* Block);
+
+    // --- ͼ־ ---
+    // ¼ռ/η仯ĵؿ飬Ĳѯݴֻڸб仯ʱʧЧ
+
+    // ؿϵĵλ仯 ( ULandblock::SetOccupyingUnit )
+    void OnTileOccupancyChanged(ULandblock* Block);
+
+    // ؿĵ/ò޸ĺã¼ƶ
+    UFUNCTION(BlueprintCallable, Category = "Map Helper")
+    void NotifyTileTerrainChanged(ULandblock* Block);
+
+    // ڼؿռõı仯Ⱥϲʱÿؿֻºͼ¼һ
+    void BeginMapChangeBatch();
+    void EndMapChangeBatch();
+
+    // ǰ־ (ÿ¼һ仯һ)
+    uint64 GetMapChangeSerial() const { return MapChangeBaseSerial + MapChangeJournal.Num(); }
+
+    //  Serial  OriginIndex  Radius ķΧǷб仯 (־ѱضʱΪб仯)
+    bool HasMapChangedNear(uint64 Serial, int32 OriginIndex, int32 Radius) const;
+
     // --- ʤжϵͳ ---
 
     // ϷǷѽ
@@ -236,6 +410,7 @@ private:
     float Grad(int32 Hash, float X, float Y);
 
     // ͼ
+    void GenerateMapTiles();
     void GenerateElevationMap(TArray<float>& OutElevation);
     void GenerateMoistureMap(TArray<float>& OutMoisture);
     void GenerateTemperatureMap(TArray<float>& OutTemperature);
@@ -243,10 +418,83 @@ private:
     ETerrain DetermineTerrain(float Elevation, float Moisture, float Temperature, int32 Y);
     ELandform DetermineLandform(ETerrain Terrain, float Elevation, float Moisture, float Temperature);
 
+    // · (ֵΪ Q12)
+    void GenerateMapTilesFixedPoint();
+    ETerrain DetermineTerrainFixed(int32 Elevation, int32 Moisture, int32 Temperature) const;
+    ELandform DetermineLandformFixed(ETerrain Terrain, int32 Elevation, int32 Moisture, int32 Temperature, int32 Index) const;
+
+    // Դ (òȷ֮󣬲Բ̲)
+    void PlaceResources();
+
+    uint32 ComputeMapChecksum() const;
+
+    // ͼ
+    FMapCacheKey MakeMapCacheKey() const;
+    bool LoadMapFromCache(const FMapCacheKey& Key);
+
     void LinkNeighbors();
     int32 GetIndex(int32 X, int32 Y) const;
     ULandblock* GetLandblock(int32 X, int32 Y) const;
 
-    // ھƫ (żквͬ)
-    void GetHexNeighborOffsets(int32 Y, TArray<FIntPoint>& OutOffsets) const;
+    // ھƫ (żквͬ)
+    void GetHexNeighborOffsets(int32 X, TArray<FIntPoint>& OutOffsets) const;
+
+    FMovementCostGrid MovementCosts;
+    uint32 MovementCostVersion = 0;
+
+    // ֲѰ·Ĵغ
+    FHexHierarchicalPathfinder PathHierarchy;
+
+    FHexPathCache PathCache;
+
+    FHexFlowFieldCache FlowFields;
+
+    // ر汾ÿؽһֻ̨ڰ汾һʱЧ
+    uint32 LandmarkVersion = 0;
+    bool bLandmarkBuildInFlight = false;
+
+    void StartLandmarkBuild();
+    void OnLandmarksBuilt(const TSharedRef<const FHexLandmarkTable>& Table, uint32 Version);
+
+    FUnitSpatialIndex UnitIndex;
+
+    FHexVisibility Visibility;
+
+    // ѵǼҰĵλͳ
+    TMap<TObjectKey<AActor>, FHexSightObserver> SightObservers;
+
+    // ÿҶб仯ĵؿļ
+    FHexTileMemory TileMemory;
+
+    // ȾǰʾĸҵҰ (INDEX_NONE ʾҪŵͼ)
+    int32 RenderedVisibilityPlayer = INDEX_NONE;
+
+    int32 LastVisibilitySwitchTiles = 0;
+    double LastVisibilitySwitchSeconds = 0.0;
+
+    // ״̬ıĵؿдصؿ󣬵ǰҵı仯ͬʱ֪ͨȾ
+    void ApplyVisibilityChanges(int32 PlayerIndex, const TArray<int32>& ChangedTiles);
+
+    // ڵ仯¼㸽۲ߵҰ
+    void RefreshSightNear(int32 TileIndex);
+
+    TWeakObjectPtr<AHexMapRenderer> CachedMapRenderer;
+
+    // Ⱦ׼׼Եĵؿ (ߴ紴һΣ֮ÿߴֻдֶ)ÿֽõĽ
+    UPROPERTY(Transient)
+    TArray<ULandblock*> BenchmarkGrid;
+
+    UPROPERTY(Transient)
+    TArray<UBuilding*> BenchmarkBuildings;
+
+    // 仯ؿʱһ
+    void RecordMapChange(int32 TileIndex);
+
+    static constexpr int32 MaxMapChangeJournal = 4096;
+    TArray<int32> MapChangeJournal;
+    uint64 MapChangeBaseSerial = 0;
+
+    // ڼռ÷仯ĵؿ
+    bool bMapChangeBatchActive = false;
+    TSet<int32> BatchedOccupancyChanges;
 };
@@ -39,6 +39,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Interaction")
     void ExecuteUnitAction(int32 ActionID);
 
+    // ѡһȴָĵλ (˯ߡ䡢פȬѵĵλҲֵ)
+    UFUNCTION(BlueprintCallable, Category = "Interaction")
+    void SelectNextUnit();
+
 protected:
     virtual void BeginPlay() override;
     virtual void SetupInputComponent() override;
@@ -60,4 +64,10 @@ private:
     void SelectCity(ACity* City);
     void SelectTile(ULandblock* Block);
     void ClearSelection();
+
+    // λغϵƶΧ (ָʱ)
+    void ShowMovementRange(AUnit* Unit);
+
+    // ѡ After ֮һȴָĵλ
+    void SelectNextUnitNeedingOrders(AUnit* After);
 };
\ No newline at end of file
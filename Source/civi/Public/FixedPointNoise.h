@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ *  (Q12)
+ * ȫʹ㣬ܱŻ (FMA ϲ) Ӱ죬ͬɵĵͼλһ
+ * ͬһе 4 ؿʹ SIMD һ
+ */
+class CIVI_API FFixedPointNoise
+{
+public:
+    // Сλ1.0 = One
+    static constexpr int32 FracBits = 12;
+    static constexpr int32 One = 1 << FracBits;
+
+    // ʹ Q16ȡֵ֣ʹ Q12 С
+    static constexpr int32 CoordFracBits = 16;
+
+    // תΪ Q12 (ڱڳ)
+    static constexpr int32 ToFixed(double Value) { return (int32)(Value * One + (Value >= 0.0 ? 0.5 : -0.5)); }
+
+    // ʱĸΪ ( 2 Ǿȷ)
+    static int32 QuantizeQ12(float Value) { return FMath::RoundToInt(Value * (float)One); }
+    static int32 QuantizeQ16(float Value) { return FMath::RoundToInt(Value * (float)(1 << CoordFracBits)); }
+
+    // ϣ (бϴơƫ͵òж)
+    static uint32 Hash(uint32 A, uint32 B, uint32 C);
+
+    // ʼб
+    void Init(int32 Seed);
+
+    // ͼ (Q12) =  * Scale + Offset
+    void GenerateField(int32 Width, int32 Height, int32 ScaleQ16, int32 OffsetXQ16, int32 OffsetYQ16,
+        int32 NumOctaves, int32 PersistenceQ12, int32 LacunarityQ12, TArray<int32>& OutField) const;
+
+private:
+    // 4 ·
+    void OctaveNoise4(const int64* CoordX, const int64* CoordY, int32 NumOctaves, int32 PersistenceQ12, int32 LacunarityQ12, int32* OutNoise) const;
+
+    // 4 ·ۼӵ Total ( Amplitude )
+    void AccumulatePerlin4(const int64* CoordX, const int64* CoordY, int32 Amplitude, VectorRegister4Int& Total) const;
+
+    int32 Permutation[512];
+};
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HexPathfinder.h"
+
+/**
+ * 
+ * Ŀؿ (ж) һη Dijkstraõÿؿ鳯Ŀǰһ
+ * ÿؿ 3 λմ洢0-5 Ϊھӷ ( FHexMath ķ˳һ)6 ΪĿ꣬7 Ϊ޷
+ * λͬһĿƶ (Χ) ʱֻҪһ
+ */
+class CIVI_API FHexFlowField
+{
+public:
+    static constexpr uint8 DirTarget = 6;
+    static constexpr uint8 DirUnreachable = 7;
+
+    // Ŀؿ鷴ŵͼÿİ MaxMovementPoints ضϣ뵥λƶһ
+    void Build(const FMovementCostGrid& Grid, TConstArrayView<int32> TargetIndices, int32 MaxMovementPoints, EMovementClass InMovementClass = EMovementClass::Land);
+
+    bool IsValid() const { return Width > 0 && Height > 0; }
+
+    uint8 GetDirection(int32 TileIndex) const
+    {
+        const int32 Word = TileIndex / TilesPerWord;
+        const int32 Shift = (TileIndex % TilesPerWord) * 3;
+        return (uint8)((Packed[Word] >> Shift) & 0x7);
+    }
+
+    // һĵؿĿϻ޷ʱ INDEX_NONE
+    int32 GetNextIndex(int32 TileIndex) const;
+
+    bool IsTarget(int32 TileIndex) const { return GetDirection(TileIndex) == DirTarget; }
+    bool IsReachable(int32 TileIndex) const { return GetDirection(TileIndex) != DirUnreachable; }
+
+    const TArray<int32>& GetTargets() const { return Targets; }
+    int32 GetMaxMovementPoints() const { return MaxMovementPoints; }
+    EMovementClass GetMovementClass() const { return MovementClass; }
+
+    // մ洢ռõֽ
+    SIZE_T GetAllocatedSize() const { return Packed.GetAllocatedSize(); }
+
+private:
+    // ÿ 64 λִ 21 ؿ
+    static constexpr int32 TilesPerWord = 21;
+
+    int32 Width = 0;
+    int32 Height = 0;
+    int32 MaxMovementPoints = 0;
+    EMovementClass MovementClass = EMovementClass::Land;
+
+    // Ŀؿ
+    TArray<int32> Targets;
+
+    TArray<uint64> Packed;
+
+    void SetDirection(int32 TileIndex, uint8 Dir)
+    {
+        const int32 Word = TileIndex / TilesPerWord;
+        const int32 Shift = (TileIndex % TilesPerWord) * 3;
+        Packed[Word] = (Packed[Word] & ~(uint64(0x7) << Shift)) | (uint64(Dir) << Shift);
+    }
+};
+
+/**
+ * 
+ *  (Ŀ꼯, ÿغƶ, ƶ) 棬 MaxIdleTurns غδʹõ
+ * λͨԱ仯ȫ
+ */
+class CIVI_API FHexFlowFieldCache
+{
+public:
+    static constexpr int32 MaxIdleTurns = 2;
+
+    // ȡʱ
+    TSharedRef<const FHexFlowField> FindOrBuild(const FMovementCostGrid& Grid, TConstArrayView<int32> TargetIndices, int32 MaxMovementPoints, EMovementClass MovementClass, int32 CurrentTurn);
+
+    // δʹõ
+    void AgeOut(int32 CurrentTurn);
+
+    void Reset() { Entries.Reset(); }
+
+    int32 Num() const { return Entries.Num(); }
+
+private:
+    struct FEntry
+    {
+        TSharedRef<const FHexFlowField> Field;
+        int32 LastUsedTurn;
+    };
+
+    // ΪĿ꼯ϡƶƶĹϣȡٱȽȷ
+    TMultiMap<uint32, FEntry> Entries;
+};
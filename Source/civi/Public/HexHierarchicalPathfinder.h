@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HexPathfinder.h"
+
+// ֲѰ·
+struct FHexHierarchicalPath
+{
+    bool bFound = false;
+
+    // · (غȡڱȽ)
+    int32 AbstractCost = 0;
+
+    // ·ڵؿ飬ǰ˳УһĿ
+    TArray<int32> Waypoints;
+
+    // ϸĵһ· (򣬸ʽ FHexPathfinder::FindPath ͬ)
+    // ӵǰλһ· FHexPathfinder::FindPath ϸ
+    TArray<int32> RefinedPath;
+
+    // ͼչĽڵ
+    int32 NodesExpanded = 0;
+};
+
+/**
+ * ֲѰ· (HPA*)
+ * ͼ ClusterSize x ClusterSize Ϊأڴصı߽Ԥȼڽڵ㣬֮Ԥȼ
+ * ԶѯֻɵСͼȻֻϸһڵ·
+ * λͨԱ仯ʱֻؽڵĴؼڱ߽
+ * ֻ½ƶ (FMovementCostGrid::Costs)
+ */
+class CIVI_API FHexHierarchicalPathfinder
+{
+public:
+    static constexpr int32 ClusterSize = 16;
+
+    // ڿȴﵽֵʱ˸һڵ㣬ֻмһ
+    static constexpr int32 MaxEntranceWidth = 6;
+
+    // 񹹽ȫ
+    void Build(const FMovementCostGrid& Grid);
+
+    // ǵؿڴҪؽ (һβѯǰͳһ)
+    void MarkTileDirty(int32 TileIndex);
+
+    // ؽбǹĴ
+    void RebuildDirtyClusters(const FMovementCostGrid& Grid);
+
+    // ԶѰ·Ͻʱֱʹ A*
+    bool FindPath(const FMovementCostGrid& Grid, int32 StartIndex, int32 GoalIndex, int32 MaxMovementPoints, FHexHierarchicalPath& OutPath);
+
+    int32 GetNumClusters() const { return Clusters.Num(); }
+    int32 GetNumNodes() const { return TotalNodes; }
+
+    // ͼ϶Ա A* ͷֲѰ·Զѯʱ
+    static void RunBenchmark(int32 Width, int32 Height, int32 NumQueries, int32 Seed);
+
+private:
+    struct FInterEdge
+    {
+        int32 TargetCluster;
+        int32 TargetTile;
+        int32 Cost;
+    };
+
+    struct FCluster
+    {
+        int32 MinX = 0;
+        int32 MinY = 0;
+        int32 SizeX = 0;
+        int32 SizeY = 0;
+
+        // ڽڵĵؿ (򣬱ڶֲ)
+        TArray<int32> NodeTiles;
+
+        // ÿڵͨڴصı
+        TArray<TArray<FInterEdge>> InterEdges;
+
+        // ڽڵ֮С (NodeTiles.Num() ƽMAX_int32 ʾͨ)
+        TArray<int32> IntraCosts;
+
+        // ȫֽڵŵʼֵ
+        int32 NodeOffset = 0;
+    };
+
+    // һڵؿ (A ڱŽСĴ)
+    struct FEntrance
+    {
+        int32 TileA;
+        int32 TileB;
+    };
+
+    int32 Width = 0;
+    int32 Height = 0;
+    int32 ClustersX = 0;
+    int32 ClustersY = 0;
+    int32 TotalNodes = 0;
+
+    TArray<FCluster> Clusters;
+
+    // ڴ֮ڣΪ (Сر, ϴر)
+    TMap<uint64, TArray<FEntrance>> Entrances;
+
+    TSet<int32> DirtyClusters;
+
+    int32 GetClusterOfTile(int32 TileIndex) const;
+    void GetNeighborClusters(int32 ClusterId, TArray<int32, TInlineAllocator<8>>& OutNeighbors) const;
+    static uint64 MakePairKey(int32 ClusterA, int32 ClusterB);
+
+    // ¼ڴ֮
+    void BuildEntrances(const FMovementCostGrid& Grid, int32 ClusterA, int32 ClusterB);
+
+    // ռصĽڵ㲢
+    void BuildClusterNodes(const FMovementCostGrid& Grid, int32 ClusterId);
+
+    void UpdateNodeOffsets();
+
+    //  DijkstraOutDist ھֲ洢bReverse ʱؿ鵽 Source 
+    void ClusterDijkstra(const FMovementCostGrid& Grid, const FCluster& Cluster, int32 SourceTile, bool bReverse, TArray<int32>& OutDist) const;
+};
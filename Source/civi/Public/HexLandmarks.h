@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HexPathfinder.h"
+
+/**
+ * ر (ALT)
+ * ÿƶѡȡ NumLandmarks ر꣬Ԥȼӵر굽ÿؿ̾ (uint16)
+ * A* ʹǲʽ½Ϊںɽ϶Ĵͼϱξö
+ * 밴 StepClamp ضϵģֻÿغƶС StepClamp Ĳѯֿɲ
+ */
+class CIVI_API FHexLandmarkTable
+{
+public:
+    static constexpr int32 NumLandmarks = 8;
+
+    // Ľضֵ (λƶ)
+    static constexpr int32 StepClamp = 2;
+
+    static constexpr uint16 Unreachable = MAX_uint16;
+
+    // Ϊÿƶѡȡر겢 (ںִ̨߳)
+    void Build(const FMovementCostGrid& Grid);
+
+    bool IsValid() const { return Width > 0; }
+
+    // ƶڵǰѯǷʹõر
+    bool CanUse(EMovementClass Class, int32 MaxMovementPoints) const
+    {
+        return MaxMovementPoints >= StepClamp && Classes[(int32)Class].Landmarks.Num() > 0;
+    }
+
+    /**
+     *  Index  Goal ½
+     * d(L, Goal) - d(L, Index)
+     * 򣺽ֻȡĿؿ飬ת·ֻıˣd(Index, Goal) = d(Goal, Index) + c(Goal) - c(Index)
+     * (Ǵ뵥ضϵʱתپȷɵǴֻʹ½)
+     */
+    FORCEINLINE int32 GetLowerBound(EMovementClass Class, const FMovementCostGrid& Grid, int32 Index, int32 Goal) const
+    {
+        const FClassLandmarks& Data = Classes[(int32)Class];
+        const bool bReverse = Class != EMovementClass::Amphibious;
+        const int32 CostDelta = bReverse ? ClampedCost(Grid, Class, Goal) - ClampedCost(Grid, Class, Index) : 0;
+
+        int32 Best = 0;
+        for (int32 L = 0; L < Data.Landmarks.Num(); L++)
+        {
+            const uint16* Dist = Data.Distances[L].GetData();
+            const int32 ToGoal = Dist[Goal];
+            const int32 ToIndex = Dist[Index];
+            if (ToGoal == Unreachable || ToIndex == Unreachable) continue;
+
+            Best = FMath::Max(Best, ToGoal - ToIndex);
+            if (bReverse)
+            {
+                Best = FMath::Max(Best, ToIndex - ToGoal + CostDelta);
+            }
+        }
+        return Best;
+    }
+
+    const TArray<int32>& GetLandmarks(EMovementClass Class) const { return Classes[(int32)Class].Landmarks; }
+
+    SIZE_T GetAllocatedSize() const;
+
+    // Աξ͵رչڵʱ (У鵽ʱһ)
+    static void RunBenchmarkOnGrid(const FMovementCostGrid& Grid, int32 NumQueries, int32 Seed, const TCHAR* Label);
+
+private:
+    struct FClassLandmarks
+    {
+        TArray<int32> Landmarks;
+
+        // Distances[L][Index]ӵ L ر굽 Index Ľض֮
+        TArray<TArray<uint16>> Distances;
+    };
+
+    int32 Width = 0;
+    int32 Height = 0;
+
+    FClassLandmarks Classes[FMovementCostGrid::NumMovementClasses];
+
+    static FORCEINLINE int32 ClampedCost(const FMovementCostGrid& Grid, EMovementClass Class, int32 Index)
+    {
+        return FMath::Min<int32>(Grid.GetCost(Class, Index), StepClamp);
+    }
+
+    //  Source  DijkstraOutDist Ϊض֮
+    static void Dijkstra(const FMovementCostGrid& Grid, EMovementClass Class, int32 Source, TArray<uint16>& OutDist);
+};
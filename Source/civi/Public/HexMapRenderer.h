@@ -8,12 +8,19 @@
 #include "BuildingDataAsset.h"
 #include "WonderDataAsset.h"
 #include "Wonder.h"
+#include "HexMath.h"
+#include "Async/ParallelFor.h"
 #include "HexMapRenderer.generated.h"
 
 class UTerrainDataAsset;
 class ULandblock;
 class UInstancedStaticMeshComponent;
 class UHierarchicalInstancedStaticMeshComponent;
+class UMeshComponent;
+class UTexture2D;
+class UMaterialInstanceDynamic;
+class FHexTileMemory;
+struct FLandformDisplayData;
 
 /**
  * εͼȾ
@@ -42,10 +49,18 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Renderer")
     float HexGap = 2.0f;
 
+    // ǰߴµβ (ʰȡ͵λλʹͬһ׹ʽ)
+    FHexLayout GetLayout() const { return FHexLayout(HexRadius, HexGap); }
+
     // ʹʵȾŻ
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Renderer")
     bool bUseInstancing = true;
 
+    // ʵ ChunkSize x ChunkSize ؿֿ飬ÿÿһ
+    // ޸ĵؿֻؽڿĲ㼶޳ҲԿΪλ
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Renderer", meta = (ClampMin = "4"))
+    int32 ChunkSize = 16;
+
     // Ⱦͼ
     UFUNCTION(BlueprintCallable, Category = "Map Renderer")
     void RenderMap(const TArray<ULandblock*>& MapGrid, int32 MapWidth, int32 MapHeight);
@@ -54,7 +69,7 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Map Renderer")
     void ClearMap();
 
-    // µؿʾ
+    // µؿʾֻ滻ͷ仯ͼʵֻӰص
     UFUNCTION(BlueprintCallable, Category = "Map Renderer")
     void UpdateTile(ULandblock* Landblock);
 
@@ -71,6 +86,42 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Map Renderer")
     void UpdateFogOfWarVisuals(const TArray<ULandblock*>& MapGrid, int32 CurrentPlayerIndex);
 
+    // ֻҰ״̬仯ĵؿ (λƶʱ)
+    void UpdateTileVisibility(const TArray<ULandblock*>& MapGrid, const TArray<int32>& TileIndices, int32 CurrentPlayerIndex);
+
+    // еĵؿ鰴󿴵ʾ (Memory Ϸģʽ)
+    void SetTileMemory(const FHexTileMemory* Memory, int32 PlayerIndex);
+
+    // ִֻȾ׼ (ͳơռ任)ֱ̺߳Ͳ NumRuns εƽʱ
+    void RunRenderPrepBenchmark(const TArray<ULandblock*>& MapGrid, int32 MapWidth, int32 MapHeight, int32 NumRuns) const;
+
+    // --- ս ---
+    // ÿؿһص R8  (0 δ̽128 255 ɼ)ֻϴ仯ж
+    // Ρò۵Ĳʶʹùʺ MF_HexFog ȾΪǴ̬ʵò
+    //   FogTexture
+    //   FogLayout(м, м, ͼ, ͼ)
+    //   FogOriginȾ
+    // ʺʵĶλûؿ飺Column = round((P.x - Origin.x) / Layout.x)
+    // Row = round((P.y - Origin.y - (Column Ϊ ? Layout.y / 2 : 0)) / Layout.y)UV = (Column + 0.5, Row + 0.5) / Layout.zw
+
+    UFUNCTION(BlueprintPure, Category = "Map Renderer")
+    UTexture2D* GetFogTexture() const { return FogTexture; }
+
+    // --- ƶΧ ---
+
+    //  (Ϊʱʹõλ)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Renderer|Highlight")
+    UStaticMesh* HighlightMesh;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Renderer|Highlight")
+    UMaterialInterface* HighlightMaterial;
+
+    // ָؿ (ؿ Y*Width+X)滻֮ǰĸ
+    void ShowMovementRange(const TArray<int32>& TileIndices);
+
+    UFUNCTION(BlueprintCallable, Category = "Map Renderer|Highlight")
+    void ClearMovementRange();
+
 protected:
     virtual void BeginPlay() override;
 
@@ -79,13 +130,13 @@ private:
     UPROPERTY()
     USceneComponent* RootSceneComponent;
 
-    // ʵͷ飩
+    // ʵֿ͵ͷ飬Ϊ MakeChunkKey
     UPROPERTY()
-    TMap<ETerrain, UHierarchicalInstancedStaticMeshComponent*> TerrainMeshComponents;
+    TMap<int32, UHierarchicalInstancedStaticMeshComponent*> TerrainMeshComponents;
 
     // òʵ
     UPROPERTY()
-    TMap<ELandform, UHierarchicalInstancedStaticMeshComponent*> LandformMeshComponents;
+    TMap<int32, UHierarchicalInstancedStaticMeshComponent*> LandformMeshComponents;
 
     // 洢ؿӦActorʵģʽ
     UPROPERTY()
@@ -97,32 +148,147 @@ private:
     // ؿ飨ʵģʽ
     AActor* SpawnTileActor(ULandblock* Landblock, const FVector& Position);
 
-    // ȡ򴴽ʵ
-    UHierarchicalInstancedStaticMeshComponent* GetOrCreateTerrainMeshComponent(ETerrain TerrainType);
-    UHierarchicalInstancedStaticMeshComponent* GetOrCreateLandformMeshComponent(ELandform LandformType);
+    // ȡ򴴽ֿ Chunk еʵ
+    UHierarchicalInstancedStaticMeshComponent* GetOrCreateTerrainMeshComponent(ETerrain TerrainType, int32 Chunk);
+    UHierarchicalInstancedStaticMeshComponent* GetOrCreateLandformMeshComponent(ELandform LandformType, int32 Chunk);
 
     // ʵӳ
     UPROPERTY()
-    TMap<EBuildingType, UHierarchicalInstancedStaticMeshComponent*> BuildingMeshComponents;
+    TMap<int32, UHierarchicalInstancedStaticMeshComponent*> BuildingMeshComponents;
 
     // ȡ򴴽
-    UHierarchicalInstancedStaticMeshComponent* GetOrCreateBuildingMeshComponent(EBuildingType BuildingType);
+    UHierarchicalInstancedStaticMeshComponent* GetOrCreateBuildingMeshComponent(EBuildingType BuildingType, int32 Chunk);
+
+    // ӳļֿź
+    static int32 MakeChunkKey(int32 Chunk, uint8 Type) { return Chunk * 256 + Type; }
+
+    // ؿڵķֿ
+    int32 GetTileChunk(int32 X, int32 Y) const { return (Y / RenderedChunkSize) * RenderedChunksX + X / RenderedChunkSize; }
 
     // 洢ɵ Actor ãԱͼʱ
     UPROPERTY()
     TArray<AWonder*> SpawnedWonderActors;
 
     // 
-    void SpawnWonder(ULandblock* Block, const FVector& Position);
+    AWonder* SpawnWonder(ULandblock* Block, const FVector& Position);
+
+    // ǰʾҵ
+    const FHexTileMemory* TileMemory = nullptr;
+    int32 TileMemoryPlayer = INDEX_NONE;
+
+    // ؿӦʾĽ (а)
+    EBuildingType GetDisplayedBuilding(int32 Index, const ULandblock* Block) const;
 
     struct FHexRenderInstance
     {
-        UHierarchicalInstancedStaticMeshComponent* Component; // ĸ
-        int32 InstanceIndex; // е
+        UHierarchicalInstancedStaticMeshComponent* Component = nullptr; // ĸ
+        int32 InstanceIndex = INDEX_NONE; // е
     };
 
+    // ÿؿʹ HISM ͼ
+    enum ETileRenderLayer : uint8
+    {
+        TerrainLayer,
+        LandformLayer,
+        BuildingLayer,
+        NumTileRenderLayers
+    };
+
+    // һؿڸͼϵʵ
+    struct FHexTileRenderInstances
+    {
+        FHexRenderInstance Layers[NumTileRenderLayers];
+        TWeakObjectPtr<AWonder> Wonder;
+    };
+
+    // һʵ (ֿ + ) ڱȾеȫʵ
+    struct FInstanceBatch
+    {
+        int32 Chunk = 0;
+        uint8 Type = 0;
+
+        TArray<FTransform> Transforms;
+
+        // ÿʵӦĵؿ
+        TArray<int32> TileIndices;
+    };
+
+    struct FRenderBatches
+    {
+        TArray<FInstanceBatch> Layers[NumTileRenderLayers];
+        TArray<int32> WonderTiles;
+    };
+
+    // ͳֱͼԤ䣬ռŵͼʵ任 ()
+    // ÿзֿڹ߳ϲдֻ֮ AddInstances ҪϷִ߳
+    void PrepareRenderBatches(const TArray<ULandblock*>& MapGrid, int32 MapWidth, int32 MapHeight, FRenderBatches& OutBatches,
+        EParallelForFlags ParallelFlags = EParallelForFlags::None) const;
+
+    // ÿһ AddInstances
+    void CommitRenderBatches(const FRenderBatches& Batches);
+
+    UHierarchicalInstancedStaticMeshComponent* GetOrCreateLayerComponent(ETileRenderLayer Layer, uint8 Type, int32 Chunk);
+
+    // ڼرղ㼶ԶؽȫӺֻһ
+    static TArray<int32> AddInstancesBatched(UHierarchicalInstancedStaticMeshComponent* Component, const TArray<FTransform>& Transforms, bool bReturnIndices);
+
     // ӳMapIndex (Y*Width+X) -> ȾʵϢ
-    TArray<FHexRenderInstance> TileRenderInstances;
+    TArray<FHexTileRenderInstances> TileRenderInstances;
+
+    // ӳ䣺ÿʵĵؿ (ɾʵʱ HISM һʵλݴؿļ¼)
+    TMap<const UHierarchicalInstancedStaticMeshComponent*, TArray<int32>> InstanceTiles;
+
+    // ѵؿĳͼ滻Ϊ Component еʵ (Component Ϊʱֻɾ)
+    void SetTileInstance(int32 TileIndex, ETileRenderLayer Layer, UHierarchicalInstancedStaticMeshComponent* Component, const FTransform& Transform);
+
+    // ɾؿĳͼʵƶʵ
+    void RemoveTileInstance(int32 TileIndex, ETileRenderLayer Layer);
+
+    // ¼ӵʵ
+    void RegisterInstances(ETileRenderLayer Layer, UHierarchicalInstancedStaticMeshComponent* Component, const TArray<int32>& TileIndices, const TArray<int32>& InstanceIndices);
+
+    // òͽʵı任 (ɵؿ)
+    static float GetTileYaw(int32 TileIndex, ETileRenderLayer Layer);
+    static FTransform MakeLandformTransform(int32 TileIndex, const FVector& Position, const FLandformDisplayData& Data);
+    static FTransform MakeBuildingTransform(int32 TileIndex, const FVector& Position, const FBuildingDisplayData& Data);
+
+    // ǰȾĵͼ (ؿת)
+    int32 RenderedMapWidth = 0;
+    int32 RenderedMapHeight = 0;
+
+    // ȾʱʹõķֿС (˷ֿ鴴֮޸ ChunkSize Ҫ´ RenderMap Ч)
+    int32 RenderedChunkSize = 16;
+    int32 RenderedChunksX = 0;
+
+    //  CPU ˸
+    UPROPERTY(Transient)
+    UTexture2D* FogTexture;
+
+    TArray<uint8> FogTexels;
+
+    // ÿдϴطΧ (X = MinX, Y = MaxXMaxX < 0 ʾûб仯)
+    TArray<FIntPoint> FogDirtySpans;
+    TArray<int32> FogDirtyRows;
+
+    // ͼߴ紴 (ȫΪδ̽)
+    void CreateFogTexture(int32 MapWidth, int32 MapHeight);
+
+    // дһؿز¼ж
+    void SetFogTexel(int32 Index, EVisibilityState State);
+
+    // ϴж
+    void FlushFogTexture();
+
+    // ΪĲʴ̬ʵ
+    void ApplyFogMaterial(UMeshComponent* Component);
+
+    // ԭ -> Ķ̬ʵ
+    UPROPERTY(Transient)
+    TMap<UMaterialInterface*, UMaterialInstanceDynamic*> FogMaterialInstances;
+
+    //  (Ƶ滻ʹ HISM ؽ㼶)
+    UPROPERTY()
+    UInstancedStaticMeshComponent* HighlightMeshComponent;
 };
 
 
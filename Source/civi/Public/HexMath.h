@@ -0,0 +1,277 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 뾶 MaxRadius ڵƫƱ ()
+ * Ϊ 0 ֮󰴻ڵУÿһඥ㿪ʼضϡϡϡ
+ * ƫ Y ƫȡеż
+ */
+struct FHexSpiralOffsets
+{
+    static constexpr int32 MaxRadius = 8;
+    static constexpr int32 NumTiles = 1 + 3 * MaxRadius * (MaxRadius + 1);
+
+    // [ż][]
+    int8 DX[NumTiles] = {};
+    int8 DY[2][NumTiles] = {};
+
+    //  Radius ڱеʼ
+    static constexpr int32 RingStart(int32 Radius) { return Radius == 0 ? 0 : 1 + 3 * Radius * (Radius - 1); }
+
+    //  Radius ĵؿ
+    static constexpr int32 RingCount(int32 Radius) { return Radius == 0 ? 1 : 6 * Radius; }
+
+    constexpr FHexSpiralOffsets()
+    {
+        // 귽˳ھӷһ
+        constexpr int32 DirQ[6] = { 1, 1, 0, -1, -1, 0 };
+        constexpr int32 DirR[6] = { -1, 0, 1, 1, 0, -1 };
+
+        int32 Index = 1;
+        for (int32 Radius = 1; Radius <= MaxRadius; Radius++)
+        {
+            int32 Q = -Radius;
+            int32 R = 0;
+            for (int32 Side = 0; Side < 6; Side++)
+            {
+                for (int32 Step = 0; Step < Radius; Step++)
+                {
+                    DX[Index] = (int8)Q;
+                    for (int32 Parity = 0; Parity < 2; Parity++)
+                    {
+                        const int32 Col = Parity + Q;
+                        DY[Parity][Index] = (int8)(R + (Col - (Col & 1)) / 2);
+                    }
+                    Index++;
+
+                    Q += DirQ[Side];
+                    R += DirR[Side];
+                }
+            }
+        }
+    }
+};
+
+/**
+ * ѧ
+ * ͼʹƽεƫ (ưȾ FHexLayout  LinkNeighbors һ)X 
+ * ʱӷż뽻棬˵ͼΪż
+ */
+struct CIVI_API FHexMath
+{
+    // ƫ ->  (Q, R)
+    static FORCEINLINE FIntPoint OffsetToAxial(int32 X, int32 Y)
+    {
+        return FIntPoint(X, Y - (X - (X & 1)) / 2);
+    }
+
+    //  -> ƫ
+    static FORCEINLINE FIntPoint AxialToOffset(int32 Q, int32 R)
+    {
+        return FIntPoint(Q, R + (Q - (Q & 1)) / 2);
+    }
+
+    //  ->  (X + Y + Z = 0)
+    static FORCEINLINE FIntVector AxialToCube(const FIntPoint& Axial)
+    {
+        return FIntVector(Axial.X, Axial.Y, -Axial.X - Axial.Y);
+    }
+
+    //  -> 
+    static FORCEINLINE FIntPoint CubeToAxial(const FIntVector& Cube)
+    {
+        return FIntPoint(Cube.X, Cube.Y);
+    }
+
+    static FORCEINLINE FIntVector OffsetToCube(int32 X, int32 Y)
+    {
+        return AxialToCube(OffsetToAxial(X, Y));
+    }
+
+    // СȡΣķƳ
+    static FORCEINLINE FIntVector CubeRound(double FracX, double FracY, double FracZ)
+    {
+        int32 RX = FMath::RoundToInt32(FracX);
+        int32 RY = FMath::RoundToInt32(FracY);
+        int32 RZ = FMath::RoundToInt32(FracZ);
+
+        const double DiffX = FMath::Abs(RX - FracX);
+        const double DiffY = FMath::Abs(RY - FracY);
+        const double DiffZ = FMath::Abs(RZ - FracZ);
+
+        if (DiffX > DiffY && DiffX > DiffZ)
+        {
+            RX = -RY - RZ;
+        }
+        else if (DiffY > DiffZ)
+        {
+            RY = -RX - RZ;
+        }
+        else
+        {
+            RZ = -RX - RY;
+        }
+        return FIntVector(RX, RY, RZ);
+    }
+
+    static FORCEINLINE int32 CubeDistance(const FIntVector& A, const FIntVector& B)
+    {
+        return (FMath::Abs(A.X - B.X) + FMath::Abs(A.Y - B.Y) + FMath::Abs(A.Z - B.Z)) / 2;
+    }
+
+    // 
+    static FORCEINLINE int32 AxialDistance(const FIntPoint& A, const FIntPoint& B)
+    {
+        const int32 DQ = A.X - B.X;
+        const int32 DR = A.Y - B.Y;
+        return (FMath::Abs(DQ) + FMath::Abs(DR) + FMath::Abs(DQ + DR)) / 2;
+    }
+
+    // ˮƽƵξ (Բεͼ)
+    static FORCEINLINE int32 Distance(int32 AX, int32 AY, int32 BX, int32 BY, int32 MapWidth)
+    {
+        const FIntPoint A = OffsetToAxial(AX, AY);
+        const FIntPoint B = OffsetToAxial(BX, BY);
+
+        // X ƽһ (ż) ͼʱ Q ƽһȣR ƽư
+        const int32 HalfWidth = MapWidth / 2;
+        const int32 Direct = AxialDistance(A, B);
+        const int32 WrapLeft = AxialDistance(A, FIntPoint(B.X - MapWidth, B.Y + HalfWidth));
+        const int32 WrapRight = AxialDistance(A, FIntPoint(B.X + MapWidth, B.Y - HalfWidth));
+        return FMath::Min3(Direct, WrapLeft, WrapRight);
+    }
+
+    //  X 껷Ƶ [0, MapWidth)
+    static FORCEINLINE int32 WrapX(int32 X, int32 MapWidth)
+    {
+        X %= MapWidth;
+        return X < 0 ? X + MapWidth : X;
+    }
+
+    // ھƫƱ [ż][]˳ ULandblock::Neighbors һ: (0), (1), (2), (3), (4), (5)
+    // Է 3
+    static constexpr int32 NeighborOffsetX[6] = { 1, 1, 0, -1, -1, 0 };
+    static constexpr int32 NeighborOffsetY[2][6] = { { -1, 0, 1, 0, -1, -1 }, { 0, 1, 1, 1, 0, -1 } };
+
+    // ȡھӵһά (X ƣY Խ緵 INDEX_NONE)
+    static FORCEINLINE int32 GetNeighborIndex(int32 X, int32 Y, int32 Dir, int32 MapWidth, int32 MapHeight)
+    {
+        const int32 NY = Y + NeighborOffsetY[X & 1][Dir];
+        if (NY < 0 || NY >= MapHeight) return INDEX_NONE;
+
+        const int32 NX = WrapX(X + NeighborOffsetX[Dir], MapWidth);
+        return NY * MapWidth + NX;
+    }
+
+    static constexpr FHexSpiralOffsets SpiralOffsets = FHexSpiralOffsets();
+
+    // 뾶 Radius ڵĵؿ ()
+    static constexpr int32 NumTilesInRadius(int32 Radius) { return 1 + 3 * Radius * (Radius + 1); }
+
+    /**
+     * ɽԶ (X, Y) 뾶 Radius ڵĵؿ飬Func(Index, Distance)
+     * X ƣY Խĵؿڴ棻뾶ƫƱʱм
+     * ͼС 2 * Radius + 1 ʱƺĵؿܱ
+     */
+    template <typename FunctionType>
+    static void ForEachInRadius(int32 X, int32 Y, int32 Radius, int32 MapWidth, int32 MapHeight, FunctionType&& Func)
+    {
+        for (int32 Ring = 0; Ring <= Radius; Ring++)
+        {
+            ForEachInRing(X, Y, Ring, MapWidth, MapHeight, Func);
+        }
+    }
+
+    //  (X, Y) ǡΪ Radius ĵؿ飬Func(Index, Distance)
+    template <typename FunctionType>
+    static void ForEachInRing(int32 X, int32 Y, int32 Radius, int32 MapWidth, int32 MapHeight, FunctionType&& Func)
+    {
+        if (Radius < 0) return;
+
+        if (Radius <= FHexSpiralOffsets::MaxRadius)
+        {
+            const int8* DY = SpiralOffsets.DY[X & 1];
+            const int32 Start = FHexSpiralOffsets::RingStart(Radius);
+            const int32 End = Start + FHexSpiralOffsets::RingCount(Radius);
+            for (int32 i = Start; i < End; i++)
+            {
+                const int32 NY = Y + DY[i];
+                if (NY < 0 || NY >= MapHeight) continue;
+
+                Func(NY * MapWidth + WrapX(X + SpiralOffsets.DX[i], MapWidth), Radius);
+            }
+            return;
+        }
+
+        // ƫƱȡϵĵ
+        const FIntPoint Center = OffsetToAxial(X, Y);
+        for (int32 DQ = -Radius; DQ <= Radius; DQ++)
+        {
+            const int32 MinDR = FMath::Max(-Radius, -DQ - Radius);
+            const int32 MaxDR = FMath::Min(Radius, -DQ + Radius);
+
+            // кжڻϣֻ
+            const int32 StepDR = (DQ == -Radius || DQ == Radius) ? 1 : FMath::Max(1, MaxDR - MinDR);
+            for (int32 DR = MinDR; DR <= MaxDR; DR += StepDR)
+            {
+                const FIntPoint Offset = AxialToOffset(Center.X + DQ, Center.Y + DR);
+                if (Offset.Y < 0 || Offset.Y >= MapHeight) continue;
+
+                Func(Offset.Y * MapWidth + WrapX(Offset.X, MapWidth), Radius);
+            }
+        }
+    }
+};
+
+/**
+ * Ⱦ֣ƽΣư ( AHexMapRenderer һ)
+ * м 0.75 * (2R + Gap)м sqrt(3) * R + Gap
+ */
+struct FHexLayout
+{
+    float HexRadius = 100.0f;
+    float HexGap = 2.0f;
+
+    FHexLayout() = default;
+
+    FHexLayout(float InHexRadius, float InHexGap)
+        : HexRadius(InHexRadius)
+        , HexGap(InHexGap)
+    {
+    }
+
+    float GetTileWidth() const { return HexRadius * 2.0f + HexGap; }
+    float GetTileHeight() const { return HexRadius * UE_SQRT_3 + HexGap; }
+
+    // ؿĵ (Z = 0)
+    FVector TileToWorld(int32 X, int32 Y) const
+    {
+        // ÿƫư
+        const FIntPoint Axial = FHexMath::OffsetToAxial(X, Y);
+        return FVector(Axial.X * GetTileWidth() * 0.75f, (Axial.Y + Axial.X * 0.5f) * GetTileHeight(), 0.0f);
+    }
+
+    /**
+     *  -> ؿ (O(1))
+     * 򰴸ԵļΪλΣתΪȡתΪƫ
+     * ڵͼʱ false
+     */
+    bool WorldToTile(const FVector& WorldPos, int32 MapWidth, int32 MapHeight, int32& OutX, int32& OutY) const
+    {
+        // λмΪ 1.5мΪ sqrt(3)
+        const double PX = WorldPos.X / (GetTileWidth() * 0.5);
+        const double PY = WorldPos.Y / (GetTileHeight() / UE_DOUBLE_SQRT_3);
+
+        const double Q = PX * (2.0 / 3.0);
+        const double R = -PX / 3.0 + PY * (UE_DOUBLE_SQRT_3 / 3.0);
+        const FIntVector Cube = FHexMath::CubeRound(Q, R, -Q - R);
+
+        const FIntPoint Tile = FHexMath::AxialToOffset(Cube.X, Cube.Y);
+        OutX = Tile.X;
+        OutY = Tile.Y;
+        return OutX >= 0 && OutX < MapWidth && OutY >= 0 && OutY < MapHeight;
+    }
+};
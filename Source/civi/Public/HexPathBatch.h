@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "HexPathfinder.h"
+
+// Ѱ·еĽ
+struct FHexPathBatchResult
+{
+    FHexPathResult Result;
+
+    // ·ʽ FHexPathfinder::FindPath ͬ
+    TArray<int32> Path;
+};
+
+/**
+ * Ѱ·
+ * ַͼĹִ߳Уÿ߳ʹԼȡͬһݲɱ
+ * ÿĽֻȡͿգ˳߳޹
+ */
+class CIVI_API FHexPathBatch
+{
+public:
+    // ύһ󣬷һһӦ futureNumWorkers Ϊ 0 ʱʹȫ߳
+    static TArray<TFuture<FHexPathBatchResult>> Submit(const TSharedRef<const FMovementCostGrid>& Snapshot, TConstArrayView<FHexPathQuery> Queries, int32 NumWorkers = 0);
+
+    // ֱ 1416 ִͬһÿ·Уһ
+    static void RunBenchmark(const TSharedRef<const FMovementCostGrid>& Snapshot, int32 NumQueries, int32 Seed);
+};
@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HexPathfinder.h"
+
+// ·ļ㡢յ㡢ƶƶ (ÿغƶͳʱʣƶıغз֣˶Ƚ)
+struct FHexPathCacheKey
+{
+    int32 StartIndex = INDEX_NONE;
+    int32 GoalIndex = INDEX_NONE;
+    int32 MaxMovementPoints = 0;
+    int32 StartMovementPoints = 0;
+    EMovementClass MovementClass = EMovementClass::Land;
+    int32 ZoneOfControlPlayer = INDEX_NONE;
+
+    FHexPathCacheKey() = default;
+
+    explicit FHexPathCacheKey(const FHexPathQuery& Query)
+        : StartIndex(Query.StartIndex)
+        , GoalIndex(Query.GoalIndex)
+        , MaxMovementPoints(Query.MaxMovementPoints)
+        , StartMovementPoints(Query.StartMovementPoints)
+        , MovementClass(Query.MovementClass)
+        , ZoneOfControlPlayer(Query.ZoneOfControlPlayer)
+    {
+    }
+
+    bool operator==(const FHexPathCacheKey& Other) const
+    {
+        return StartIndex == Other.StartIndex && GoalIndex == Other.GoalIndex
+            && MaxMovementPoints == Other.MaxMovementPoints && StartMovementPoints == Other.StartMovementPoints
+            && MovementClass == Other.MovementClass && ZoneOfControlPlayer == Other.ZoneOfControlPlayer;
+    }
+
+    friend uint32 GetTypeHash(const FHexPathCacheKey& Key)
+    {
+        uint32 Hash = HashCombineFast(::GetTypeHash(Key.StartIndex), ::GetTypeHash(Key.GoalIndex));
+        Hash = HashCombineFast(Hash, ::GetTypeHash((Key.MaxMovementPoints << 16) | (Key.StartMovementPoints & 0xFFFF)));
+        return HashCombineFast(Hash, ::GetTypeHash(((int32)Key.MovementClass << 24) ^ Key.ZoneOfControlPlayer));
+    }
+};
+
+/**
+ * Ѱ·
+ * ͬһ·ߵĵλ (Ϳߡˡ̶) ֱӸ֮ǰĽ
+ * ͼ RegionSize x RegionSize  (ֲѰ·Ĵһ)ÿ¼
+ * ĳڵƶġͨԻ仯ʱֻ̭ļ¼
+ * λռñӰ A* ˲ᵼ̭
+ */
+class CIVI_API FHexPathCache
+{
+public:
+    static constexpr int32 RegionSize = 16;
+
+    // ޣﵽ̭δʹõķ֮һ
+    static constexpr int32 MaxEntries = 4096;
+
+    // ͼߴ仯 (ɵͼ) ʱ
+    void Reset(int32 InWidth, int32 InHeight);
+
+    // ʱƻ· (򣬸ʽ FHexPathfinder::FindPath ͬ)
+    bool Find(const FHexPathQuery& Query, FHexPathResult& OutResult, TArray<int32>& OutPath);
+
+    // ¼һγɹѰ· (Ҳ·Ľ)
+    void Add(const FHexPathQuery& Query, const FHexPathResult& Result, const TArray<int32>& Path);
+
+    // ѯ棬δʱִ A* д뻺
+    FHexPathResult FindPath(const FMovementCostGrid& Grid, const FHexPathQuery& Query, TArray<int32>& OutPath);
+
+    // ؿƶġͨԻ仯̭ļ¼
+    void InvalidateTile(int32 TileIndex);
+
+    int32 Num() const { return Entries.Num(); }
+    uint64 GetHits() const { return Hits; }
+    uint64 GetMisses() const { return Misses; }
+    uint64 GetEvictions() const { return Evictions; }
+
+    // ʵͳ
+    void LogStats() const;
+
+private:
+    struct FEntry
+    {
+        FHexPathResult Result;
+        TArray<int32> Path;
+
+        //  (ظ)
+        TArray<int32, TInlineAllocator<8>> Regions;
+
+        uint64 LastUsed = 0;
+    };
+
+    int32 Width = 0;
+    int32 Height = 0;
+    int32 RegionsX = 0;
+
+    TMap<FHexPathCacheKey, FEntry> Entries;
+
+    //  -> Ļ
+    TMap<int32, TArray<FHexPathCacheKey>> RegionEntries;
+
+    uint64 UseCounter = 0;
+    uint64 Hits = 0;
+    uint64 Misses = 0;
+    uint64 Evictions = 0;
+
+    int32 GetRegionOfTile(int32 TileIndex) const;
+
+    // ɾһ¼Ƴ
+    void RemoveEntry(const FHexPathCacheKey& Key, int32 SkipRegion);
+
+    void EvictOldest();
+};
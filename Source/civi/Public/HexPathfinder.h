@@ -0,0 +1,226 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CiviTypes.h"
+
+class ULandblock;
+class UTerraindataasset;
+class FHexLandmarkTable;
+
+/**
+ * ƶ
+ * Ѱ·ʹõĴݿգ UObject̶߳ȡ
+ * ƶֱ洢 (½ءǴ)㸲ǵĵؿ黥ص
+ * ÿƶʹһ㣬Ԥȼͨͨ O(1) ܾ
+ */
+struct CIVI_API FMovementCostGrid
+{
+    static constexpr int32 NumMovementClasses = (int32)EMovementClass::Count;
+
+    int32 Width = 0;
+    int32 Height = 0;
+
+    // ½ز㣺ÿؿʱƶģ0 ʾͨ
+    // ֲѰ·ֻ½صλģֱӶȡһ
+    TArray<uint8> Costs;
+
+    // Ǵ (ǳ)
+    TArray<uint8> EmbarkedCosts;
+
+    //  (ֻǳ)
+    TArray<uint8> NavalCosts;
+
+    // 
+    TArray<uint8> DeepOceanCosts;
+
+    // Ǵ½Ķ
+    uint8 EmbarkCost = 1;
+
+    // ÿƶͨţINDEX_NONE ʾ𲻿ͨ
+    TArray<int32> Components[NumMovementClasses];
+
+    // ؿǷеλ (ƶΧѯͣ򴩹)
+    TBitArray<> Occupied;
+
+    // ZoneOfControl[P]  P ĵλ󱾻غϱͣµĵؿ (зµλڼڵؿ)
+    TArray<TBitArray<>> ZoneOfControl;
+
+    // ÿҵľµλǸؿĴ (άڵλ뿪ʱжϿǷȻ)
+    TArray<TArray<uint8>> ZoneOfControlCounts;
+
+    // ҸǸؿĴ֮ͣ P ڿҽ Total - Counts[P] > 0
+    TArray<uint16> ZoneOfControlTotal;
+
+    // ر (ɱ䣬֮乲α仯ÿգɺ̨ؽ滻)
+    TSharedPtr<const FHexLandmarkTable> Landmarks;
+
+    bool IsValid() const { return Width > 0 && Height > 0 && Costs.Num() == Width * Height; }
+    int32 Num() const { return Costs.Num(); }
+
+    bool IsOccupied(int32 Index) const { return Occupied.IsValidIndex(Index) && Occupied[Index]; }
+    void SetOccupied(int32 Index, bool bOccupied) { if (Occupied.IsValidIndex(Index)) Occupied[Index] = bOccupied; }
+
+    // ƶؿģ0 ʾͨ
+    FORCEINLINE uint8 GetCost(EMovementClass Class, int32 Index) const
+    {
+        switch (Class)
+        {
+        case EMovementClass::Amphibious: return Costs[Index] != 0 ? Costs[Index] : EmbarkedCosts[Index];
+        case EMovementClass::Naval:      return NavalCosts[Index];
+        case EMovementClass::OceanGoing: return NavalCosts[Index] != 0 ? NavalCosts[Index] : DeepOceanCosts[Index];
+        default:                         return Costs[Index];
+        }
+    }
+
+    //  From ߵڵ To  (δض)Ǵ/½ʱ϶
+    FORCEINLINE int32 GetStepCost(EMovementClass Class, int32 From, int32 To) const
+    {
+        int32 Cost = GetCost(Class, To);
+        if (Class == EMovementClass::Amphibious && (Costs[From] == 0) != (Costs[To] == 0))
+        {
+            Cost += EmbarkCost;
+        }
+        return Cost;
+    }
+
+    FORCEINLINE bool IsInZoneOfControl(int32 Player, int32 Index) const
+    {
+        return ZoneOfControl.IsValidIndex(Player) && ZoneOfControl[Player][Index];
+    }
+
+    // ֤ NumPlayers ҵĿ (ҵĿеλƳ)
+    void EnsureZoneOfControlPlayers(int32 NumPlayers);
+
+    //  OwnerPlayer ľµλ (Delta = 1) 뿪 (Delta = -1) ؿ飬¸õؿ鼰 6 ھӵĿ
+    void UpdateZoneOfControl(int32 OwnerPlayer, int32 TileIndex, int32 Delta);
+
+    // ؿԸƶǷͨ (ͨеĵؿΪͨ)
+    FORCEINLINE bool AreConnected(EMovementClass Class, int32 A, int32 B) const
+    {
+        const TArray<int32>& Labels = Components[(int32)Class];
+        return Labels.IsValidIndex(A) && Labels.IsValidIndex(B) && Labels[A] != INDEX_NONE && Labels[A] == Labels[B];
+    }
+
+    // ݵؿ͵ι½زĽ (ʹ DataAsset )
+    static uint8 ComputeTileCost(const ULandblock* Block, const UTerraindataasset* TerrainData);
+
+    // ¼㵥ؿڸģһƶͨǷı (Ҫؽͨ)
+    bool UpdateTile(int32 Index, const ULandblock* Block, const UTerraindataasset* TerrainData);
+
+    // ӵͼؽ
+    void Build(const TArray<ULandblock*>& MapGrid, int32 InWidth, int32 InHeight, const UTerraindataasset* TerrainData);
+
+    // ȫΪ 0 ĸ (Եͼд½ز㣬ٵ BuildComponents)
+    void InitEmpty(int32 InWidth, int32 InHeight);
+
+    // ±ƶͨ
+    void BuildComponents();
+};
+
+// Ѱ·
+struct FHexPathQuery
+{
+    int32 StartIndex = INDEX_NONE;
+    int32 GoalIndex = INDEX_NONE;
+
+    // λÿغϵƶ
+    int32 MaxMovementPoints = 2;
+
+    // غʣƶ
+    int32 StartMovementPoints = 2;
+
+    EMovementClass MovementClass = EMovementClass::Land;
+
+    // ҵĿ (INDEX_NONE ʾԿ)
+    int32 ZoneOfControlPlayer = INDEX_NONE;
+
+    // ƿĵؿ (ϻغϵס·ĵλڵؿ飻յ)
+    int32 AvoidIndex = INDEX_NONE;
+
+    // еرʱʹõر (رڶԱȲ)
+    bool bUseLandmarks = true;
+};
+
+// Ѱ·
+struct FHexPathResult
+{
+    bool bFound = false;
+
+    // ĿҪĻغ (غڵΪ 1)
+    int32 Turns = 0;
+
+    // ʱ (غ * ƶ + غƶ)
+    int32 ArrivalTime = 0;
+
+    // չĽڵ
+    int32 NodesExpanded = 0;
+};
+
+// ƶΧڵĵؿ
+struct FReachableTile
+{
+    int32 Index = INDEX_NONE;
+
+    // ʣƶ
+    int32 RemainingMP = 0;
+
+    // һĵؿ (Ϊ INDEX_NONE)
+    int32 Predecessor = INDEX_NONE;
+};
+
+// غϿɵĵؿ鼯 (ĴСУԪ)
+struct CIVI_API FHexReachableSet
+{
+    int32 OriginIndex = INDEX_NONE;
+
+    // ʱƶҲǿӰ뾶
+    int32 MovementPoints = 0;
+
+    TArray<FReachableTile> Tiles;
+
+    void Reset() { OriginIndex = INDEX_NONE; MovementPoints = 0; Tiles.Reset(); }
+
+    // ҵؿڼеλãɵﷵ INDEX_NONE
+    int32 FindSlot(int32 TileIndex) const;
+
+    bool Contains(int32 TileIndex) const { return FindSlot(TileIndex) != INDEX_NONE; }
+
+    // ǰؽ·ʽ FHexPathfinder::FindPath ͬ (򣬲)
+    bool BuildPathTo(int32 TileIndex, TArray<int32>& OutPath) const;
+};
+
+/**
+ *  A* Ѱ·
+ * ۰غϼ㣺ʣƶԽһؿʱȵ»غϣĲƶ
+ * ƶȡĲ㣬յ㲻ͬһͨʱֱӷ
+ * зĵؿľغϵƶ (Ŀؿ)
+ * ΪǻƵξ룬еرʱȡر½Ľϴֵ״̬ÿ̸߳õĻУѯ̲ڴ
+ */
+class CIVI_API FHexPathfinder
+{
+public:
+    // OutPath Ϊĵؿ (ԪĿ꣬ĩβǵһ) Pop
+    static FHexPathResult FindPath(const FMovementCostGrid& Grid, const FHexPathQuery& Query, TArray<int32>& OutPath);
+
+    // н Dijkstraغ MovementPoints ڿɵĵؿ (СʹͰ)
+    // зĵؿټչ (ZoneOfControlPlayer Ϊ INDEX_NONE ʱԿ)
+    static void FindReachable(const FMovementCostGrid& Grid, int32 OriginIndex, int32 MovementPoints, int32 MaxMovementPoints, FHexReachableSet& OutReachable,
+        EMovementClass MovementClass = EMovementClass::Land, int32 ZoneOfControlPlayer = INDEX_NONE);
+
+    // ƶ (ƶʱǰһ)
+    static FORCEINLINE int32 ClampStepCost(int32 Cost, int32 MaxMovementPoints)
+    {
+        return FMath::Min(Cost, MaxMovementPoints);
+    }
+
+    // ܲԵ
+    static void MakeRandomGrid(int32 Width, int32 Height, int32 Seed, FMovementCostGrid& OutGrid);
+
+    // ɵĵͼִѯƽʱ
+    static void RunBenchmark(int32 Width, int32 Height, int32 NumQueries, int32 Seed);
+
+    // ִָѯ
+    static void RunBenchmarkOnGrid(const FMovementCostGrid& Grid, int32 NumQueries, int32 Seed, const TCHAR* Label);
+};
@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CiviTypes.h"
+
+class ULandblock;
+class FHexVisibility;
+
+// ؿϻб仯ֶ (ΡòڴУǵı仯ڵƶĵ)
+struct CIVI_API FHexTileSnapshot
+{
+    EBuildingType Building = EBuildingType::None;
+
+    //  (INDEX_NONE ʾ)
+    int8 OwnerPlayer = INDEX_NONE;
+
+    // ؿǷг
+    bool bHasCity = false;
+
+    bool operator==(const FHexTileSnapshot& Other) const
+    {
+        return Building == Other.Building && OwnerPlayer == Other.OwnerPlayer && bHasCity == Other.bHasCity;
+    }
+    bool operator!=(const FHexTileSnapshot& Other) const { return !(*this == Other); }
+
+    // ȡؿʵʱ״̬
+    static FHexTileSnapshot Capture(const ULandblock* Block);
+};
+
+/**
+ * еؿ "󿴵" 
+ * ÿֻз仯ĵؿľɿգؿֱӶȡʵʱͼ
+ * ڴҼʵʵͼĲͼС
+ */
+class CIVI_API FHexTileMemory
+{
+public:
+    void Init(int32 NumPlayers);
+
+    // ؿĿɱֶμı (Current Ϊıǰʵʱ״̬)
+    // ޼Ҽ¾ɿգɼҿʵʱ״̬δ̽ʲôҲ
+    void RecordBeforeChange(int32 TileIndex, const FHexTileSnapshot& Current, const FHexVisibility& Visibility);
+
+    // ؿ½ҰҶļ䣻Ƿڹ
+    bool Forget(int32 Player, int32 TileIndex);
+
+    // ҵǰɼؿȫ (Ұ)
+    void ForgetVisible(int32 Player, const FHexVisibility& Visibility, TArray<int32>& OutForgotten);
+
+    // ҼеĿ (ûмʱΪգʾʵʱ״̬һ)
+    const FHexTileSnapshot* Find(int32 Player, int32 TileIndex) const
+    {
+        return PlayerMemory.IsValidIndex(Player) ? PlayerMemory[Player].Find(TileIndex) : nullptr;
+    }
+
+    // еĵؿ飺δ̽ʱؿտգмʱؼ䣬򷵻ʵʱ״̬
+    FHexTileSnapshot GetSeen(int32 Player, int32 TileIndex, const ULandblock* Block, const FHexVisibility& Visibility) const;
+
+    // һмĵؿ (лʱЩؿʾܲͬ)
+    void GetRememberedTiles(int32 PlayerA, int32 PlayerB, TArray<int32>& OutTiles) const;
+
+    int32 GetNumEntries(int32 Player) const { return PlayerMemory.IsValidIndex(Player) ? PlayerMemory[Player].Num() : 0; }
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    TArray<TMap<int32, FHexTileSnapshot>> PlayerMemory;
+};
@@ -0,0 +1,181 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CiviTypes.h"
+#include "HexMath.h"
+
+class ULandblock;
+
+/**
+ * ߱
+ * ԰뾶 MaxSightRadius ڵÿĿ꣬Ԥȼ¼ĵĿ߶ξмؿ (ƫƱŴ洢)
+ * ߶ǡþؿĽʱƫһΣõߣһͨɼ
+ * ŻΪƫʱ۲еż FHexSpiralOffsets::DYͬһűż
+ */
+struct CIVI_API FHexSightRays
+{
+    static constexpr int32 MaxSightRadius = 5;
+    static constexpr int32 NumTargets = FHexMath::NumTilesInRadius(MaxSightRadius);
+
+    struct FRay
+    {
+        uint16 Start = 0;
+        uint8 Count = 0;
+    };
+
+    // ÿĿһ
+    FRay Rays[NumTargets][2];
+    uint8 NumRays[NumTargets] = {};
+
+    // ߾мؿ (ţĺĿ)
+    TArray<uint8> Steps;
+
+    static const FHexSightRays& Get();
+
+private:
+    FHexSightRays();
+};
+
+// ۲߿ɼĵؿ (ŵλ۲λһʹ)
+struct FHexSightMask
+{
+    static constexpr int32 NumWords = (FHexSightRays::NumTargets + 63) / 64;
+
+    uint64 Words[NumWords] = {};
+
+    void Reset() { FMemory::Memzero(Words); }
+    void Set(int32 Slot) { Words[Slot >> 6] |= 1ull << (Slot & 63); }
+    bool Test(int32 Slot) const { return (Words[Slot >> 6] >> (Slot & 63)) & 1; }
+
+    // Func(Slot)
+    template <typename FunctionType>
+    void ForEachSlot(FunctionType&& Func) const
+    {
+        for (int32 Word = 0; Word < NumWords; Word++)
+        {
+            for (uint64 Bits = Words[Word]; Bits != 0; Bits &= Bits - 1)
+            {
+                Func(Word * 64 + (int32)FMath::CountTrailingZeros64(Bits));
+            }
+        }
+    }
+};
+
+// һ۲ (λ) ǰǼǵҰ
+struct FHexSightObserver
+{
+    int32 Player = INDEX_NONE;
+    int32 X = 0;
+    int32 Y = 0;
+    int32 Radius = 0;
+    FHexSightMask Mask;
+};
+
+/**
+ * Ұ
+ * ɽڵй۲ߣꡢɭֻ֡ڵƽϵĹ۲ (վϿԿȥ)
+ * ڵؿ鱾ɼ󷽵ĵؿ鲻ɼ
+ * ÿҶÿؿ鱣濴Ĺ۲ 0 ͷ 0 ֮仯ʱлɼ/
+ * ۲ƶʱֻ뿪Ұĵؿ飬״̬ıĵؿͨ OutChanged 
+ */
+class CIVI_API FHexVisibility
+{
+public:
+    // λĬҰͳҰ
+    static constexpr int32 DefaultSightRadius = 2;
+    static constexpr int32 CitySightRadius = 2;
+
+    void Init(int32 InWidth, int32 InHeight, int32 NumPlayers);
+
+    bool IsValid() const { return Width > 0 && Height > 0; }
+    int32 GetNumPlayers() const { return Players.Num(); }
+
+    // ݵòؽڵλ
+    void BuildBlockers(const TArray<ULandblock*>& MapGrid);
+
+    // ؿĵò仯ڵ
+    void UpdateBlocker(int32 Index, const ULandblock* Block);
+
+    //  (X, Y) 뾶 Radius ڵĿɼؿ (Radius  MaxSightRadius)
+    void ComputeSight(int32 X, int32 Y, int32 Radius, FHexSightMask& OutMask) const;
+
+    // λ (X, Y) Ĺ۲ߵĿɼؿ飬Func(TileIndex)
+    template <typename FunctionType>
+    void ForEachVisibleTile(int32 X, int32 Y, const FHexSightMask& Mask, FunctionType&& Func) const
+    {
+        const int8* DX = FHexMath::SpiralOffsets.DX;
+        const int8* DY = FHexMath::SpiralOffsets.DY[X & 1];
+        Mask.ForEachSlot([&](int32 Slot)
+        {
+            Func((Y + DY[Slot]) * Width + FHexMath::WrapX(X + DX[Slot], Width));
+        });
+    }
+
+    // ҵĹ۲߼͵ǰҰ (̽ĵؿ鱣)
+    void ResetPlayer(int32 Player);
+
+    // Ǽǹ۲ߵĿɼΧ
+    void AddSight(int32 Player, int32 X, int32 Y, const FHexSightMask& Mask, TArray<int32>& OutChanged);
+
+    // ۲ߵĿɼΧ
+    void RemoveSight(int32 Player, int32 X, int32 Y, const FHexSightMask& Mask, TArray<int32>& OutChanged);
+
+    // ۲ߴӾλƶλãֻҰĲ
+    void MoveSight(int32 Player, int32 OldX, int32 OldY, const FHexSightMask& OldMask,
+        int32 NewX, int32 NewY, const FHexSightMask& NewMask, TArray<int32>& OutChanged);
+
+    bool IsVisible(int32 Player, int32 Index) const { return Players.IsValidIndex(Player) && Players[Player].Visible[Index]; }
+    bool IsExplored(int32 Player, int32 Index) const { return Players.IsValidIndex(Player) && Players[Player].Explored[Index]; }
+
+    // ʾ״̬ (ɼ̽) ͬĵؿ飺ֶλƽ
+    void GetDifferingTiles(int32 PlayerA, int32 PlayerB, TArray<int32>& OutTiles) const;
+
+    EVisibilityState GetState(int32 Player, int32 Index) const
+    {
+        if (IsVisible(Player, Index)) return EVisibilityState::Visible;
+        return IsExplored(Player, Index) ? EVisibilityState::FogOfWar : EVisibilityState::Unexplored;
+    }
+
+private:
+    struct FPlayerPlanes
+    {
+        TBitArray<> Visible;
+        TBitArray<> Explored;
+
+        // õؿĹ۲ (ÿؿΧ MaxSightRadius ڵĵλͳԶ 255)
+        TArray<uint8> ObserverCounts;
+    };
+
+    FORCEINLINE void IncrementObserver(FPlayerPlanes& Planes, int32 Index, TArray<int32>& OutChanged)
+    {
+        if (Planes.ObserverCounts[Index]++ == 0)
+        {
+            Planes.Visible[Index] = true;
+            Planes.Explored[Index] = true;
+            OutChanged.Add(Index);
+        }
+    }
+
+    FORCEINLINE void DecrementObserver(FPlayerPlanes& Planes, int32 Index, TArray<int32>& OutChanged)
+    {
+        checkSlow(Planes.ObserverCounts[Index] > 0);
+        if (--Planes.ObserverCounts[Index] == 0)
+        {
+            Planes.Visible[Index] = false;
+            OutChanged.Add(Index);
+        }
+    }
+
+    int32 Width = 0;
+    int32 Height = 0;
+
+    // Blockers[0]ƽع۲ߵڵBlockers[1]ߴ۲ߵڵ (ɽ)
+    TBitArray<> Blockers[2];
+
+    // վڸõؿϵĹ۲λڸߴ ()
+    TBitArray<> Elevated;
+
+    TArray<FPlayerPlanes> Players;
+};
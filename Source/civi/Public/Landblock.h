@@ -37,8 +37,12 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Landblock")
     ELandform Landform;
 
+    // Դ
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Landblock")
+    EResourceType Resource;
+
     // Χ6ھ (εͼ)
-    // ˳: (0), (1), (2), (3), (4), (5)
+    // ˳: (0), (1), (2), (3), (4), (5)
     UPROPERTY(BlueprintReadOnly, Category = "Landblock")
     TArray<ULandblock*> Neighbors;
 
@@ -59,7 +63,7 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Landblock")
     bool IsWater() const;
 
-    // Ƿͨ
+    // ½صλǷͨ (ˮɵǴʹֻƶ)
     UFUNCTION(BlueprintCallable, Category = "Landblock")
     bool IsPassable() const;
 
@@ -107,8 +111,8 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "City")
     ACity* OwningCity = nullptr;
 
-    // 
-    void SetOwningCity(ACity* NewCity) { OwningCity = NewCity; }
+    //  (еҼסɵ)
+    void SetOwningCity(ACity* NewCity);
 
     // ǰؿϵսλÿֻһսλ
     UPROPERTY(BlueprintReadOnly, Category = "Unit")
@@ -117,4 +121,7 @@ public:
     // Ƿеλ
     bool HasUnit() const { return OccupyingUnit != nullptr; }
 
+    // ռõλ (ͬʱ¼ͼ־)
+    void SetOccupyingUnit(AUnit* NewUnit);
+
 };
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ULandblock;
+
+// ͼɽȫ
+struct FMapCacheKey
+{
+    int32 Seed = 0;
+    int32 Width = 0;
+    int32 Height = 0;
+
+    float ElevationScale = 0.0f;
+    float MoistureScale = 0.0f;
+    float TemperatureScale = 0.0f;
+    int32 Octaves = 0;
+    float Persistence = 0.0f;
+    float Lacunarity = 0.0f;
+
+    // Ƿʹö
+    bool bFixedPointNoise = false;
+
+    // ԴùĹϣ
+    uint32 ResourceRulesHash = 0;
+
+    // Ĺϣ (汾)
+    uint64 ComputeHash() const;
+};
+
+// ļеؿĽռ¼
+struct FMapCacheTile
+{
+    uint8 Terrain;
+    uint8 Landform;
+    uint8 Wonder;
+    uint8 Resource;
+};
+
+/**
+ * ɵͼĴ̻
+ * ͬӺͲĵͼֱӴڴӳļȡ
+ */
+class CIVI_API FMapCache
+{
+public:
+    // ͼ㷨汾ţ޸߼ʱɻԶʧЧ
+    static constexpr uint32 GeneratorVersion = 5;
+
+    // ļ· (Saved/MapCache/<Hash>.civimap)
+    static FString GetCacheFilePath(const FMapCacheKey& Key);
+
+    // ͼд뻺
+    static bool Save(const FMapCacheKey& Key, const TArray<ULandblock*>& MapGrid);
+
+    // Զȡ棬ʱӳڴеļ¼ Visitor
+    static bool Load(const FMapCacheKey& Key, TFunctionRef<void(const FMapCacheTile* Tiles, int32 NumTiles)> Visitor);
+
+private:
+    struct FHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint64 KeyHash;
+        int32 Width;
+        int32 Height;
+        uint32 NumTiles;
+        uint32 PayloadCrc;
+    };
+
+    static constexpr uint32 FileMagic = 0x4D564943; // "CIVM"
+};
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CiviTypes.h"
+#include "ResourceDataAsset.generated.h"
+
+// Դķù
+USTRUCT(BlueprintType)
+struct FResourceInfo
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    EResourceType ResourceType = EResourceType::None;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FText DisplayName;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    EResourceClass ResourceClass = EResourceClass::Bonus;
+
+    // ֵĵ
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement")
+    TArray<ETerrain> ValidTerrains;
+
+    // ֵĵò ( None ʾԳ޵òĵؿ)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement")
+    TArray<ELandform> ValidLandforms;
+
+    // Ȩ (ͬһؿжѡԴʱȨ)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement")
+    int32 Weight = 10;
+
+    // ԴҪĵؿʩ
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement")
+    EBuildingType Improvement = EBuildingType::None;
+
+    bool CanPlaceOn(ETerrain Terrain, ELandform Landform) const
+    {
+        return Weight > 0 && ValidTerrains.Contains(Terrain) && ValidLandforms.Contains(Landform);
+    }
+};
+
+UCLASS(BlueprintType)
+class CIVI_API UResourceDataAsset : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Resource Data")
+    TArray<FResourceInfo> Resources;
+
+    // Դ֮Сξ (Բ̲뾶)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement", meta = (ClampMin = "1"))
+    int32 MinSpacing = 2;
+
+    // շԴĸ
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float PlacementChance = 0.8f;
+
+    UFUNCTION(BlueprintCallable, Category = "Resource Data")
+    FResourceInfo GetResourceInfo(EResourceType Type) const;
+
+    // ǷκԴԷڸõ/ò
+    bool HasResourceFor(ETerrain Terrain, ELandform Landform) const;
+
+    // ùĹϣ (仯ʱͼʧЧ)
+    uint32 GetPlacementRulesHash() const;
+};
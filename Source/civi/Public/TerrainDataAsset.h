@@ -124,6 +124,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Landform Data")
     TArray<FLandformDisplayData> LandformData;
 
+    // Ǵ½ʱĵƶ
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement")
+    int32 EmbarkMovementCost = 1;
+
     // λ
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hex Settings")
     UStaticMesh* HexBaseMesh;
@@ -139,4 +143,7 @@ public:
     // ݵòͻȡʾ
     UFUNCTION(BlueprintCallable, Category = "Terrain Data")
     FLandformDisplayData GetLandformDisplayData(ELandform LandformType) const;
+
+    // ƵĲ (ȾʱͲһ)δʱؿ
+    const FLandformDisplayData* FindLandformDisplayData(ELandform LandformType) const;
 };
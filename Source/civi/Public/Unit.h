@@ -6,11 +6,13 @@
 #include "GameFramework/Actor.h"
 #include "CiviTypes.h"
 #include "CombatFunctionLibrary.h"
+#include "HexPathfinder.h"
 #include "Unit.generated.h"
 
 class ULandblock;
 class UUnitDataAsset;
 class ACity;
+struct FHexPathBatchResult;
 
 UCLASS()
 class CIVI_API AUnit : public AActor
@@ -19,6 +21,7 @@ class CIVI_API AUnit : public AActor
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
     // --- ʼ ---
@@ -45,6 +48,18 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Unit Stats")
     int32 CombatStrength;
 
+    // Զ̹ (0 ʾԶ)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Unit Stats")
+    int32 RangedStrength = 0;
+
+    //  (ξ)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Unit Stats")
+    int32 Range = 0;
+
+    // Ұ뾶
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Unit Stats")
+    int32 SightRange = 2;
+
     // ƶ
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
     int32 MovementPoints;
@@ -52,6 +67,10 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
     int32 MaxMovementPoints;
 
+    // ƶ (ɽĵκǷܵǴ)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
+    EMovementClass MovementClass = EMovementClass::Land;
+
     // λ
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Location")
     ULandblock* CurrentBlock;
@@ -66,12 +85,27 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State")
     bool bIsFortified;
 
+    // ǰĳ
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Orders")
+    EUnitOrder CurrentOrder = EUnitOrder::None;
+
     // --- Ϊ ---
 
-    // ƶĿؿ (Ѱ·ļ)
+    // ƶĿؿ (Ѱ·ļ)غ߲·֮Ļغϼ
     UFUNCTION(BlueprintCallable, Category = "Unit Action")
     bool MoveTo(ULandblock* TargetBlock);
 
+    // Ƿδ·
+    UFUNCTION(BlueprintPure, Category = "Unit Action")
+    bool HasPendingMove() const { return PendingPath.Num() > 0; }
+
+    // ȡδ· (ͬʱȡǰ/̽ͬ CancelOrder)
+    UFUNCTION(BlueprintCallable, Category = "Unit Action")
+    void ClearPendingMove() { CancelOrder(); }
+
+    // غʣƶɵĵؿ (λ棬λƶƶ仯Χڵĵͼ仯¼)
+    const FHexReachableSet& GetReachableTiles();
+
     // Ŀ굥λ
     UFUNCTION(BlueprintCallable, Category = "Unit Action")
     void AttackUnit(AUnit* Defender);
@@ -84,6 +118,50 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Unit Action")
     void Fortify();
 
+    // ---  ---
+
+    // ߣ֮ĻغϲҪָ
+    UFUNCTION(BlueprintCallable, Category = "Orders")
+    void Sleep();
+
+    // 䣺зλ AlertRadius ʱ
+    UFUNCTION(BlueprintCallable, Category = "Orders")
+    void Alert();
+
+    // Զ̽ÿغϳδ̽ؿǰ
+    UFUNCTION(BlueprintCallable, Category = "Orders")
+    void AutoExplore();
+
+    // פֱֵ
+    UFUNCTION(BlueprintCallable, Category = "Orders")
+    void FortifyUntilHealed();
+
+    // ȡǰ (ѵλ)
+    UFUNCTION(BlueprintCallable, Category = "Orders")
+    void CancelOrder();
+
+    // Ƿڵȴ´ָ (ƶûг)
+    UFUNCTION(BlueprintPure, Category = "Orders")
+    bool NeedsOrders() const { return MovementPoints > 0 && CurrentOrder == EUnitOrder::None && !bIsFortified; }
+
+    // ĻѰ뾶
+    static constexpr int32 AlertRadius = 2;
+
+    // Զ̽Ѱδ̽ؿ뾶
+    static constexpr int32 ExploreRadius = 12;
+
+    // غϿʼ ( GameMode )״̬·Ҫ¼ʱд OutQuery  true
+    bool PrepareTurnOrder(FHexPathQuery& OutQuery);
+
+    // غϿʼӦѰ·Ľ
+    void ApplyOrderPath(FHexPathBatchResult& Result);
+
+    // غϿʼ·ǰǷƶ
+    bool ExecuteOrderMove();
+
+    // غϿʼеλƶһԱռʱ·ʧЧ»غƿõؿѰ·
+    void MarkBlockedOrderPath();
+
     // غϿʼʱõ
     UFUNCTION(BlueprintCallable, Category = "Turn System")
     void OnTurnStart();
@@ -97,6 +175,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Unit Action")
     void AttackCity(ACity* TargetCity);
 
+    // عƽ (λΧͬһʱֻһ)ڵؿ𹥳
+    UFUNCTION(BlueprintCallable, Category = "Unit Action")
+    bool AdvanceOnCity(ACity* TargetCity);
+
     // Զ̹λ
     UFUNCTION(BlueprintCallable, Category = "Unit Action")
     void RangedAttackUnit(AUnit* TargetUnit);
@@ -105,6 +187,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Unit Action")
     void RangedAttackCity(ACity* TargetCity);
 
+    // ĿǷ (ǵͼˮƽ)
+    UFUNCTION(BlueprintPure, Category = "Combat")
+    bool IsInRange(int32 TargetX, int32 TargetY) const;
+
+    // ǷԵзʩӿ (µλ)
+    UFUNCTION(BlueprintPure, Category = "Combat")
+    bool ExertsZoneOfControl() const;
+
     // ȡǰ ()
     UFUNCTION(BlueprintPure, Category = "Combat")
     int32 GetDefensiveStrength() const;
@@ -115,4 +205,30 @@ private:
 
     // λ
     void UpdateWorldLocation();
+
+    // ش·ǰֱƶ赲
+    void ContinuePendingMove();
+
+    // ƶһ񲢿۳ƶ
+    void StepTo(ULandblock* NextBlock, int32 Cost);
+
+    // · (ؿ洢ĩβһ)
+    TArray<int32> PendingPath;
+
+    //  PendingPath ʱƶİ汾α仯ڻغϿʼʱѰ·
+    uint32 PendingPathVersion = 0;
+
+    // Ŀؿ
+    int32 OrderGoalIndex = INDEX_NONE;
+
+    // ϻغϵס·ĵؿ (Ѱ·ʱƿ)
+    int32 BlockedStepIndex = INDEX_NONE;
+
+    // Զ̽ڰ뾶Ŀɵδ̽ؿ
+    int32 FindExploreTarget() const;
+
+    // ƶΧ
+    FHexReachableSet CachedReachable;
+    uint64 CachedReachableSerial = 0;
+    bool bHasCachedReachable = false;
 };
\ No newline at end of file
@@ -24,6 +24,10 @@ struct FUnitInfo
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     int32 MaxMovementPoints = 2;
 
+    // ƶ (½ءɵǴֻ)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    EMovementClass MovementClass = EMovementClass::Land;
+
     // ս
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     int32 CombatStrength = 10;
@@ -36,6 +40,10 @@ struct FUnitInfo
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     int32 Range = 0;
 
+    // Ұ뾶 (ꡢɽɭڵ)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 SightRange = 2;
+
     // ɱ
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     int32 ProductionCost = 40;
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class AUnit;
+
+/**
+ * λռ
+ * ÿһſռϣͼ CellSize x CellSize Ϊӣڴŵλ
+ * λƶʱͬ (AUnit::InitUnit / StepTo / EndPlay)
+ * ԶСвͼ AI Ŀѡÿغ϶ҪķΧѯ
+ */
+class CIVI_API FUnitSpatialIndex
+{
+public:
+    static constexpr int32 CellSize = 8;
+
+    // ͼߴ仯ʱ
+    void Reset(int32 InWidth, int32 InHeight);
+
+    void AddUnit(AUnit* Unit, int32 X, int32 Y);
+    void RemoveUnit(AUnit* Unit, int32 X, int32 Y);
+
+    // λ (FromX, FromY) ƶ (ToX, ToY)ʱ޸
+    void MoveUnit(AUnit* Unit, int32 FromX, int32 FromY, int32 ToX, int32 ToY);
+
+    //  PlayerIndex  (X, Y)  Radius ĵλFunc(AUnit*, Distance)
+    template <typename FunctionType>
+    void ForEachUnitInRadius(int32 PlayerIndex, int32 X, int32 Y, int32 Radius, FunctionType&& Func) const
+    {
+        if (!Players.IsValidIndex(PlayerIndex) || Width <= 0 || Radius < 0) return;
+
+        const FPlayerCells& Cells = Players[PlayerIndex];
+        const int32 MinCellY = FMath::Max(0, (Y - Radius) / CellSize);
+        const int32 MaxCellY = FMath::Min(CellsY - 1, (Y + Radius) / CellSize);
+
+        // зĩиӿܽխȡһУ뾶ŵͼʱÿֻһ
+        const int32 CenterCellX = X / CellSize;
+        const int32 ReachX = Radius / CellSize + 2;
+        const int32 LoDX = -FMath::Min(ReachX, CellsX / 2);
+        const int32 HiDX = FMath::Min(ReachX, (CellsX - 1) / 2);
+
+        for (int32 CellY = MinCellY; CellY <= MaxCellY; CellY++)
+        {
+            for (int32 DX = LoDX; DX <= HiDX; DX++)
+            {
+                const int32 CellX = WrapCellX(CenterCellX + DX);
+                for (const TWeakObjectPtr<AUnit>& Handle : Cells[CellY * CellsX + CellX])
+                {
+                    AUnit* Unit = Handle.Get();
+                    if (!Unit) continue;
+
+                    const int32 Dist = GetUnitDistance(Unit, X, Y);
+                    if (Dist <= Radius)
+                    {
+                        Func(Unit, Dist);
+                    }
+                }
+            }
+        }
+    }
+
+    // ռ PlayerIndex  (X, Y)  Radius ĵλ
+    void GetUnitsInRadius(int32 PlayerIndex, int32 X, int32 Y, int32 Radius, TArray<AUnit*>& OutUnits) const;
+
+    //  (X, Y) ķ PlayerIndex ҵλMaxRadius ûʱ nullptr
+    AUnit* FindNearestEnemy(int32 PlayerIndex, int32 X, int32 Y, int32 MaxRadius, int32* OutDistance = nullptr) const;
+
+    int32 Num() const { return NumUnits; }
+
+private:
+    // һҵȫӣ±Ϊ CellY * CellsX + CellX
+    using FPlayerCells = TArray<TArray<TWeakObjectPtr<AUnit>, TInlineAllocator<4>>>;
+
+    int32 Width = 0;
+    int32 Height = 0;
+    int32 CellsX = 0;
+    int32 CellsY = 0;
+    int32 NumUnits = 0;
+
+    TArray<FPlayerCells> Players;
+
+    int32 GetCellIndex(int32 X, int32 Y) const { return (Y / CellSize) * CellsX + X / CellSize; }
+
+    int32 WrapCellX(int32 CellX) const
+    {
+        CellX %= CellsX;
+        return CellX < 0 ? CellX + CellsX : CellX;
+    }
+
+    int32 GetUnitDistance(const AUnit* Unit, int32 X, int32 Y) const;
+
+    // Ϊҷ
+    FPlayerCells* GetOrAddPlayer(int32 PlayerIndex);
+};